@@ -0,0 +1,271 @@
+#include "AssetBundle.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+
+namespace {
+constexpr char kBundleMagic[4] = {'I', 'T', 'P', 'K'};
+constexpr std::uint16_t kBundleVersion = 1;
+constexpr std::size_t kBundleHeaderSize = 16;
+constexpr std::size_t kIndexFixedSize = 23;  // 오프셋(8) 크기(8) CRC(4) 종류(1) 경로 길이(2)
+
+template <typename T>
+void PutRaw(std::string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+T TakeRaw(const char* in) {
+    T value;
+    std::memcpy(&value, in, sizeof(T));
+    return value;
+}
+
+std::string NormalizeAssetPath(const std::string& path) {
+    return std::filesystem::path(path).lexically_normal().generic_string();
+}
+}  // 익명 네임스페이스 종료
+
+bool AssetBundle::Open(const std::string& path) {
+    entries_.clear();
+    if (!file_.Open(path)) return false;
+
+    std::string_view data = file_.View();
+    if (data.size() < kBundleHeaderSize || std::memcmp(data.data(), kBundleMagic, sizeof(kBundleMagic)) != 0 ||
+        TakeRaw<std::uint16_t>(data.data() + 4) != kBundleVersion) {
+        std::cerr << "[AssetBundle] 번들 헤더가 올바르지 않습니다: " << path << '\n';
+        file_.Close();
+        return false;
+    }
+    auto count = TakeRaw<std::uint32_t>(data.data() + 8);
+    auto indexSize = TakeRaw<std::uint32_t>(data.data() + 12);
+    if (data.size() < kBundleHeaderSize + indexSize) {
+        std::cerr << "[AssetBundle] 번들 색인이 잘렸습니다: " << path << '\n';
+        file_.Close();
+        return false;
+    }
+
+    std::string_view index = data.substr(kBundleHeaderSize, indexSize);
+    std::vector<Entry> entries;
+    entries.reserve(count);
+    std::size_t pos = 0;
+    for (std::uint32_t i = 0; i < count; ++i) {
+        if (pos + kIndexFixedSize > index.size()) break;
+        const char* raw = index.data() + pos;
+        Entry entry;
+        entry.offset = TakeRaw<std::uint64_t>(raw);
+        entry.size = TakeRaw<std::uint64_t>(raw + 8);
+        entry.crc = TakeRaw<std::uint32_t>(raw + 16);
+        entry.kind = static_cast<Kind>(static_cast<std::uint8_t>(raw[20]));
+        auto pathLength = TakeRaw<std::uint16_t>(raw + 21);
+        pos += kIndexFixedSize;
+        if (pos + pathLength > index.size()) break;
+        entry.path = index.substr(pos, pathLength);
+        pos += pathLength;
+        entries.push_back(entry);
+    }
+    if (entries.size() != count) {
+        std::cerr << "[AssetBundle] 번들 색인이 손상되었습니다: " << path << '\n';
+        file_.Close();
+        return false;
+    }
+    entries_ = std::move(entries);
+    return true;
+}
+
+const AssetBundle::Entry* AssetBundle::Find(std::string_view path) const {
+    auto it = std::lower_bound(entries_.begin(), entries_.end(), path,
+                               [](const Entry& entry, std::string_view key) { return entry.path < key; });
+    if (it == entries_.end() || it->path != path) return nullptr;
+    return &*it;
+}
+
+std::vector<std::string_view> AssetBundle::List(std::string_view directory) const {
+    // 색인이 경로순으로 정렬되어 있으므로 접두사 구간만 훑습니다.
+    std::string prefix(directory);
+    if (!prefix.empty() && prefix.back() != '/') prefix += '/';
+    std::vector<std::string_view> paths;
+    auto it = std::lower_bound(entries_.begin(), entries_.end(), std::string_view(prefix),
+                               [](const Entry& entry, std::string_view key) { return entry.path < key; });
+    for (; it != entries_.end() && it->path.substr(0, prefix.size()) == prefix; ++it) {
+        if (it->path.find('/', prefix.size()) == std::string_view::npos) {
+            paths.push_back(it->path);
+        }
+    }
+    return paths;
+}
+
+bool AssetBundle::Read(const Entry& entry, std::string_view& out) const {
+    std::string_view data = file_.View();
+    if (entry.offset > data.size() || entry.size > data.size() - entry.offset) return false;
+    out = data.substr(static_cast<std::size_t>(entry.offset), static_cast<std::size_t>(entry.size));
+    if (FileIO::Crc32(out) != entry.crc) {
+        std::cerr << "[AssetBundle] 에셋 체크섬이 맞지 않습니다: " << entry.path << '\n';
+        return false;
+    }
+    return true;
+}
+
+bool AssetBundle::Build(const std::string& root, const std::string& prefix, const std::string& outPath) {
+    namespace fs = std::filesystem;
+    struct Pending {
+        std::string path;
+        Kind kind;
+        std::string body;
+    };
+
+    std::error_code ec;
+    std::vector<Pending> assets;
+    for (const auto& file : fs::recursive_directory_iterator(root, ec)) {
+        if (!file.is_regular_file()) continue;
+        Pending asset;
+        asset.path = NormalizeAssetPath(prefix + "/" + fs::relative(file.path(), root).generic_string());
+        if (!FileIO::ReadAll(file.path().string(), asset.body)) {
+            std::cerr << "[AssetBundle] 파일을 읽을 수 없습니다: " << file.path().string() << '\n';
+            return false;
+        }
+        asset.kind = Kind::Raw;
+        if (file.path().extension() == ".json") {
+            // JSON은 미리 파싱해 MessagePack으로 저장합니다. 잘못된 JSON은 빌드 단계에서 실패시킵니다.
+            nlohmann::json doc = nlohmann::json::parse(asset.body, nullptr, false);
+            if (doc.is_discarded()) {
+                std::cerr << "[AssetBundle] JSON 파싱 오류: " << file.path().string() << '\n';
+                return false;
+            }
+            std::vector<std::uint8_t> packed = nlohmann::json::to_msgpack(doc);
+            asset.body.assign(packed.begin(), packed.end());
+            asset.kind = Kind::MsgPack;
+        }
+        assets.push_back(std::move(asset));
+    }
+    if (ec) {
+        std::cerr << "[AssetBundle] 디렉토리를 읽을 수 없습니다(" << root << "): " << ec.message() << '\n';
+        return false;
+    }
+    std::sort(assets.begin(), assets.end(), [](const Pending& a, const Pending& b) { return a.path < b.path; });
+
+    std::size_t indexSize = 0;
+    for (const auto& asset : assets) indexSize += kIndexFixedSize + asset.path.size();
+
+    std::string out;
+    out.append(kBundleMagic, sizeof(kBundleMagic));
+    PutRaw(out, kBundleVersion);
+    PutRaw(out, static_cast<std::uint16_t>(0));
+    PutRaw(out, static_cast<std::uint32_t>(assets.size()));
+    PutRaw(out, static_cast<std::uint32_t>(indexSize));
+
+    std::uint64_t offset = kBundleHeaderSize + indexSize;
+    for (const auto& asset : assets) {
+        PutRaw(out, offset);
+        PutRaw(out, static_cast<std::uint64_t>(asset.body.size()));
+        PutRaw(out, FileIO::Crc32(asset.body));
+        PutRaw(out, static_cast<std::uint8_t>(asset.kind));
+        PutRaw(out, static_cast<std::uint16_t>(asset.path.size()));
+        out += asset.path;
+        offset += asset.body.size();
+    }
+    for (const auto& asset : assets) {
+        out += asset.body;
+    }
+    // 빌드 산출물이므로 직전 세대를 남기지 않습니다.
+    return FileIO::ReplaceAtomic(outPath, out);
+}
+
+bool Assets::Mount(const std::string& bundlePath) {
+    std::error_code ec;
+    if (!std::filesystem::exists(bundlePath, ec)) return false;
+    return Bundle().Open(bundlePath);
+}
+
+bool Assets::Exists(const std::string& path) {
+    std::error_code ec;
+    return Find(path) != nullptr || std::filesystem::is_regular_file(path, ec);
+}
+
+bool Assets::InBundle(const std::string& path) {
+    return Find(path) != nullptr;
+}
+
+bool Assets::LoadJson(const std::string& path, nlohmann::json& out) {
+    const AssetBundle::Entry* entry = Find(path);
+    if (!entry) {
+        return JsonHelper::LoadFromFile(path, out);
+    }
+    std::string_view body;
+    if (!Bundle().Read(*entry, body)) return false;
+    out = entry->kind == AssetBundle::Kind::MsgPack
+        ? nlohmann::json::from_msgpack(body.begin(), body.end(), true, false)
+        : nlohmann::json::parse(body.begin(), body.end(), nullptr, false);
+    if (out.is_discarded()) {
+        std::cerr << "[Assets] 번들의 JSON 에셋이 손상되었습니다: " << path << '\n';
+        return false;
+    }
+    return true;
+}
+
+bool Assets::StreamJson(const std::string& path, const std::string& arrayKey, nlohmann::json& out,
+                        const JsonStreamingSax::ElementHandler& onElement) {
+    if (!Find(path)) {
+        return JsonHelper::StreamFromFile(path, arrayKey, out, onElement);
+    }
+    // 번들 에셋은 이미 바이너리이므로 디코딩한 뒤 배열 원소를 같은 방식으로 넘겨줍니다.
+    if (!LoadJson(path, out)) return false;
+    nlohmann::json* array = arrayKey.empty() ? &out
+                          : out.is_object() && out.contains(arrayKey) ? &out[arrayKey]
+                                                                      : nullptr;
+    if (!array || !array->is_array()) return true;
+    nlohmann::json elements = std::move(*array);
+    *array = nlohmann::json::array();
+    for (auto& element : elements) {
+        if (!onElement(std::move(element))) return false;
+    }
+    return true;
+}
+
+bool Assets::LoadText(const std::string& path, std::string& out) {
+    const AssetBundle::Entry* entry = Find(path);
+    if (!entry) {
+        MappedFile file;
+        if (!file.Open(path)) return false;
+        out.assign(file.View());
+        return true;
+    }
+    std::string_view body;
+    if (!Bundle().Read(*entry, body)) return false;
+    out.assign(body);
+    return true;
+}
+
+std::vector<std::string> Assets::List(const std::string& directory, const std::string& extension) {
+    namespace fs = std::filesystem;
+    std::vector<std::string> names;
+    AssetBundle& bundle = Bundle();
+    if (bundle.IsOpen()) {
+        for (std::string_view path : bundle.List(NormalizeAssetPath(directory))) {
+            fs::path file(path);
+            if (file.extension() == extension) names.push_back(file.filename().string());
+        }
+    }
+    std::error_code ec;
+    for (const auto& file : fs::directory_iterator(directory, ec)) {
+        if (file.is_regular_file() && file.path().extension() == extension) {
+            names.push_back(file.path().filename().string());
+        }
+    }
+    std::sort(names.begin(), names.end());
+    names.erase(std::unique(names.begin(), names.end()), names.end());
+    return names;
+}
+
+AssetBundle& Assets::Bundle() {
+    static AssetBundle bundle;
+    return bundle;
+}
+
+const AssetBundle::Entry* Assets::Find(const std::string& path) {
+    AssetBundle& bundle = Bundle();
+    if (!bundle.IsOpen()) return nullptr;
+    return bundle.Find(NormalizeAssetPath(path));
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "FileIO.h"
+#include "JsonHelper.h"
+
+/**
+ * `data/` 디렉토리를 하나로 묶은 읽기 전용 에셋 번들(`data.pak`)입니다.
+ *
+ * [매직 "ITPK"(4)][버전(2)][예약(2)][항목 수(4)][색인 크기(4)]
+ * [색인: 오프셋(8) 크기(8) CRC(4) 종류(1) 경로 길이(2) 경로 × N (경로순 정렬)][본문...]
+ *
+ * JSON 에셋은 빌드할 때 MessagePack으로 변환해 두므로 실행 중에는 텍스트 파싱이 없고,
+ * 번들은 한 번만 열어 메모리 매핑한 채로 색인을 이진 탐색합니다.
+ */
+class AssetBundle {
+public:
+    enum class Kind : std::uint8_t {
+        Raw = 0,      // 텍스트 등 원본 그대로
+        MsgPack = 1   // 미리 변환한 JSON
+    };
+
+    struct Entry {
+        std::string_view path;  // 매핑된 색인을 가리킵니다.
+        std::uint64_t offset = 0;
+        std::uint64_t size = 0;
+        std::uint32_t crc = 0;
+        Kind kind = Kind::Raw;
+    };
+
+    // 번들 파일을 매핑하고 색인을 읽습니다.
+    bool Open(const std::string& path);
+
+    // 번들이 열려 있는지 반환합니다.
+    bool IsOpen() const { return !entries_.empty(); }
+
+    // 경로(`data/...`, '/' 구분)로 항목을 찾습니다. 없으면 nullptr을 반환합니다.
+    const Entry* Find(std::string_view path) const;
+
+    // `directory/` 바로 아래에 있는 항목의 경로를 반환합니다.
+    std::vector<std::string_view> List(std::string_view directory) const;
+
+    // 항목 본문을 복사 없이 가리키는 뷰를 돌려줍니다. 체크섬이 맞지 않으면 false를 반환합니다.
+    bool Read(const Entry& entry, std::string_view& out) const;
+
+    // `root` 디렉토리 전체를 `prefix/상대경로` 키로 묶어 `outPath`에 씁니다. (빌드 도구용)
+    static bool Build(const std::string& root, const std::string& prefix, const std::string& outPath);
+
+private:
+    MappedFile file_;
+    std::vector<Entry> entries_;
+};
+
+/**
+ * 에셋 로드 창구입니다. 번들이 연결되어 있으면 번들에서 읽고,
+ * 번들에 없거나 번들을 쓰지 않는 개발 환경에서는 개별 파일을 읽습니다.
+ */
+class Assets {
+public:
+    // 번들을 연결합니다. 파일이 없으면 false를 반환하고 개별 파일 모드로 동작합니다.
+    static bool Mount(const std::string& bundlePath);
+
+    // 번들이나 개별 파일로 에셋이 있는지 반환합니다.
+    static bool Exists(const std::string& path);
+
+    // 번들에 든 에셋인지 반환합니다. (같은 경로의 개별 파일보다 번들이 우선)
+    static bool InBundle(const std::string& path);
+
+    // JSON 에셋을 읽습니다.
+    static bool LoadJson(const std::string& path, nlohmann::json& out);
+
+    // JSON 에셋의 큰 배열을 원소 단위로 읽습니다. (JsonHelper::StreamFromFile과 같은 규칙)
+    static bool StreamJson(const std::string& path, const std::string& arrayKey, nlohmann::json& out,
+                           const JsonStreamingSax::ElementHandler& onElement);
+
+    // 텍스트 에셋을 읽습니다.
+    static bool LoadText(const std::string& path, std::string& out);
+
+    // `directory` 바로 아래에서 확장자가 `extension`인 에셋의 파일 이름을 정렬해 반환합니다. (번들과 개별 파일을 합침)
+    static std::vector<std::string> List(const std::string& directory, const std::string& extension);
+
+private:
+    static AssetBundle& Bundle();
+    static const AssetBundle::Entry* Find(const std::string& path);
+};
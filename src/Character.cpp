@@ -6,7 +6,6 @@ namespace {
 constexpr int kMinAffection = -100;
 constexpr int kMaxAffection = 100;
 constexpr int kMinStage = 0;
-constexpr int kMaxStage = 3;
 }  // 익명 네임스페이스 종료
 
 Character::Character() : Character("Unknown") {}
@@ -16,6 +15,14 @@ Character::Character(std::string name)
       affection_(10),
       relationshipStage_(0) {}
 
+const std::string& Character::GetId() const {
+    return id_;
+}
+
+void Character::SetId(const std::string& id) {
+    id_ = id;
+}
+
 const std::string& Character::GetName() const {
     return name_;
 }
@@ -41,11 +48,7 @@ int Character::GetRelationshipStage() const {
 }
 
 void Character::SetRelationshipStage(int stage) {
-    relationshipStage_ = std::clamp(stage, kMinStage, kMaxStage);
-}
-
-void Character::AdvanceRelationshipStage() {
-    SetRelationshipStage(relationshipStage_ + 1);
+    relationshipStage_ = std::max(stage, kMinStage);
 }
 
 const std::vector<std::string>& Character::GetTraits() const {
@@ -64,19 +67,38 @@ StageInfo Character::GetStageInfo(int stageIdx) const {
     return {"알 수 없음", "이 단계에 대한 행동 정의가 없습니다."};
 }
 
-void Character::MarkEventTriggered(int threshold) {
-    triggeredEvents_[threshold] = true;
+void Character::MarkEventTriggered(const std::string& eventId) {
+    triggeredEvents_.insert(eventId);
 }
 
-bool Character::HasTriggeredEvent(int threshold) const {
-    auto it = triggeredEvents_.find(threshold);
-    return it != triggeredEvents_.end() && it->second;
+bool Character::HasTriggeredEvent(const std::string& eventId) const {
+    return triggeredEvents_.count(eventId) > 0;
 }
 
-const std::unordered_map<int, bool>& Character::GetTriggeredEvents() const {
+const std::set<std::string>& Character::GetTriggeredEvents() const {
     return triggeredEvents_;
 }
 
-std::unordered_map<int, bool>& Character::EditableTriggeredEvents() {
-    return triggeredEvents_;
+const std::vector<int>& Character::GetLegacyTriggeredThresholds() const {
+    return legacyTriggeredThresholds_;
+}
+
+void Character::ClearLegacyTriggeredThresholds() {
+    legacyTriggeredThresholds_.clear();
+}
+
+void Character::SetFlag(const std::string& flag) {
+    flags_.insert(flag);
+}
+
+bool Character::HasFlag(const std::string& flag) const {
+    return flags_.count(flag) > 0;
+}
+
+void Character::MarkKeywordSaid(const std::string& keyword) {
+    saidKeywords_.insert(keyword);
+}
+
+bool Character::HasSaidKeyword(const std::string& keyword) const {
+    return saidKeywords_.count(keyword) > 0;
 }
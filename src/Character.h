@@ -4,6 +4,7 @@
 #include <unordered_map>
 #include <vector>
 #include <map>
+#include <set>
 #include <nlohmann/json.hpp>
 
 struct StageInfo {
@@ -24,6 +25,12 @@ public:
     // 이름을 받는 생성자
     explicit Character(std::string name);
 
+    // 로스터에서 캐릭터를 찾는 식별자를 반환합니다. (캐릭터 파일 이름, 이전 세이브는 빈 문자열)
+    const std::string& GetId() const;
+
+    // 식별자를 설정합니다.
+    void SetId(const std::string& id);
+
     // 캐릭터의 표시 이름을 반환합니다.
     const std::string& GetName() const;
 
@@ -39,15 +46,12 @@ public:
     // 호감도 값을 [0, 100] 범위 내에서 증감시킵니다.
     void AddAffection(int delta);
 
-    // 관계 단계(0-3)를 반환합니다.
+    // 관계 단계를 반환합니다. (단계 수는 캐릭터의 StageTable이 정함)
     int GetRelationshipStage() const;
 
-    // 관계 단계를 [0, 3] 범위로 제한하여 설정합니다.
+    // 관계 단계를 설정합니다. 음수는 0으로 맞춥니다.
     void SetRelationshipStage(int stage);
 
-    // 가능하다면 관계 단계를 한 단계 올립니다.
-    void AdvanceRelationshipStage();
-
     // 변경 불가능한 성격 특성을 반환합니다.
     const std::vector<std::string>& GetTraits() const;
 
@@ -57,47 +61,81 @@ public:
     // 인덱스를 기반으로 단계 정보를 가져오는 헬퍼 함수입니다.
     StageInfo GetStageInfo(int stageIdx) const;
 
-    // 임계값 기반 이벤트가 발생했음을 표시합니다.
-    void MarkEventTriggered(int threshold);
+    // 이벤트가 발생했음을 id로 표시합니다.
+    void MarkEventTriggered(const std::string& eventId);
+
+    // 주어진 이벤트가 이미 발생했는지 반환합니다.
+    bool HasTriggeredEvent(const std::string& eventId) const;
+
+    // 영구 저장을 위해 발생한 이벤트 id를 모두 반환합니다.
+    const std::set<std::string>& GetTriggeredEvents() const;
 
-    // 주어진 임계값 이벤트가 이미 발생했는지 반환합니다.
-    bool HasTriggeredEvent(int threshold) const;
+    // 임계값으로만 발생을 기록하던 이전 세이브의 임계값 목록을 반환합니다. (EventProgress가 id로 옮김)
+    const std::vector<int>& GetLegacyTriggeredThresholds() const;
 
-    // 영구 저장을 위해 모든 트리거된 임계값을 반환합니다.
-    const std::unordered_map<int, bool>& GetTriggeredEvents() const;
+    // id로 옮긴 뒤 이전 임계값 기록을 비웁니다.
+    void ClearLegacyTriggeredThresholds();
 
-    // 저장 불라오기를 위한 트리거된 맵의 가변 참조를 반환합니다.
-    std::unordered_map<int, bool>& EditableTriggeredEvents();
+    // 이벤트가 켠 플래그를 기록합니다. (이벤트 조건식의 flag("...")로 확인)
+    void SetFlag(const std::string& flag);
+
+    // 플래그가 켜져 있는지 반환합니다.
+    bool HasFlag(const std::string& flag) const;
+
+    // 이벤트 조건식이 찾는 키워드를 플레이어가 말했음을 기록합니다.
+    void MarkKeywordSaid(const std::string& keyword);
+
+    // 플레이어가 키워드를 말한 적이 있는지 반환합니다.
+    bool HasSaidKeyword(const std::string& keyword) const;
 
 private:
+    std::string id_;
     std::string name_;
     int affection_;
     int relationshipStage_;
     std::vector<std::string> traits_;
 
-    std::unordered_map<int, bool> triggeredEvents_;
+    std::set<std::string> triggeredEvents_;
+    std::vector<int> legacyTriggeredThresholds_;
+    std::set<std::string> flags_;
+    std::set<std::string> saidKeywords_;
     std::map<int, StageInfo> emotionStages_;
 
     friend void to_json(nlohmann::json& j, const Character& p) {
         j = nlohmann::json{
+            {"id", p.id_},
             {"name", p.name_},
             {"affection", p.affection_},
             {"relationshipStage", p.relationshipStage_},
             {"traits", p.traits_},
-            {"triggered", p.triggeredEvents_},
+            {"triggeredEvents", p.triggeredEvents_},
+            {"flags", p.flags_},
+            {"saidKeywords", p.saidKeywords_},
             {"emotionStages", p.emotionStages_}
         };
+        // 아직 id로 옮기지 못한 이전 기록은 그대로 다시 씁니다.
+        if (!p.legacyTriggeredThresholds_.empty()) {
+            std::unordered_map<int, bool> legacy;
+            for (int threshold : p.legacyTriggeredThresholds_) legacy[threshold] = true;
+            j["triggered"] = legacy;
+        }
     }
 
     friend void from_json(const nlohmann::json& j, Character& p) {
+        p.id_ = j.value("id", "");
         p.name_ = j.value("name", "Unknown");
         p.affection_ = j.value("affection", 10);
         p.relationshipStage_ = j.value("relationshipStage", 0);
         p.traits_ = j.value("traits", std::vector<std::string>{});
-        // nlohmann::json automatically handles conversion for std::unordered_map<int, bool>
-        // if keys are string representations of integers.
-        if (j.contains("triggered")) {
-             p.triggeredEvents_ = j["triggered"].get<std::unordered_map<int, bool>>();
+        p.triggeredEvents_ = j.value("triggeredEvents", std::set<std::string>{});
+        p.flags_ = j.value("flags", std::set<std::string>{});
+        p.saidKeywords_ = j.value("saidKeywords", std::set<std::string>{});
+        // 이전 세이브는 임계값을 키로 기록했습니다. ([[25, true]] 형식)
+        p.legacyTriggeredThresholds_.clear();
+        if (j.contains("triggered") && j["triggered"].is_array()) {
+            for (const auto& [threshold, fired] : j["triggered"].get<std::unordered_map<int, bool>>()) {
+                if (fired) p.legacyTriggeredThresholds_.push_back(threshold);
+            }
         }
         if (j.contains("emotionStages")) {
              p.emotionStages_ = j["emotionStages"].get<std::map<int, StageInfo>>();
@@ -0,0 +1,292 @@
+#include "CharacterRoster.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <iterator>
+
+#include "AssetBundle.h"
+#include "Config.h"
+
+namespace {
+std::string JoinPath(const std::string& base, const std::string& name) {
+    return (std::filesystem::path(base) / name).generic_string();
+}
+
+// 캐시가 이미 읽은 개별 파일 내용을 JSON으로 파싱합니다.
+bool ParseJsonText(const std::string& path, const std::string& text, nlohmann::json& out) {
+    out = nlohmann::json::parse(text, nullptr, false);
+    if (out.is_discarded()) {
+        std::cerr << "[CharacterRoster] JSON 파싱 오류: " << path << '\n';
+        return false;
+    }
+    return true;
+}
+
+// 이벤트 묶음은 원소 단위로 스트리밍해 바로 Event로 변환합니다. (전체 DOM을 만들지 않음)
+// `contents`가 있으면 그 내용을, 없으면 Assets로 파일을 읽습니다.
+bool LoadEventPack(const std::string& filePath, const std::string* contents, std::vector<Event>& events) {
+    std::vector<Event> loaded;
+    nlohmann::json doc;
+    auto onEntry = [&](nlohmann::json&& entry) {
+        try {
+            loaded.push_back(entry.get<Event>());
+        } catch (const nlohmann::json::exception& e) {
+            std::cerr << "JSON Parsing Error: " << e.what() << std::endl;
+            std::cerr << "Dump: " << entry.dump(4) << std::endl;
+            return false;
+        }
+        return true;
+    };
+    bool ok = false;
+    if (contents) {
+        JsonStreamingSax sax(doc, "", onEntry);
+        ok = nlohmann::json::sax_parse(contents->begin(), contents->end(), &sax);
+        if (!ok) std::cerr << "[CharacterRoster] JSON 파싱 오류(" << filePath << "): " << sax.Error() << '\n';
+    } else {
+        ok = Assets::StreamJson(filePath, "", doc, onEntry);
+    }
+    if (!ok) {
+        return false;
+    }
+    if (!doc.is_array()) {
+        std::cerr << "Error: Events file root is not an array." << std::endl;
+        return false;
+    }
+    events = std::move(loaded);
+    return true;
+}
+
+std::size_t EstimateFootprint(const CharacterAssets& assets) {
+    std::size_t bytes = sizeof(CharacterAssets);
+    for (const auto& prompt : assets.stagePrompts) bytes += prompt.capacity();
+    for (const auto& trait : assets.persona.GetTraits()) bytes += trait.capacity();
+    for (std::size_t i = 0; i < assets.events->Size(); ++i) {
+        const Event& event = assets.events->At(i);
+        bytes += sizeof(Event) + event.id.capacity() + event.title.capacity() + event.condition.capacity();
+    }
+    bytes += assets.events->Script().MemoryBytes();
+    return bytes;
+}
+}  // 익명 네임스페이스 종료
+
+const std::string& CharacterAssets::StagePrompt(int stage) const {
+    static const std::string kEmpty;
+    if (stage < 0 || stage >= static_cast<int>(stagePrompts.size())) return kEmpty;
+    return stagePrompts[static_cast<std::size_t>(stage)];
+}
+
+CharacterRoster::CharacterRoster(const Config& config)
+    : charactersDir_(config.GetCharactersDir()),
+      sharedEventsFile_(config.GetEventsFile()),
+      defaultAffection_(config.GetDefaultInitialAffection()),
+      capBytes_(static_cast<std::size_t>(std::max(0, config.GetRosterMemoryCapKb())) * 1024),
+      residentBytes_(0) {}
+
+std::size_t CharacterRoster::Scan() {
+    ids_.clear();
+    index_.clear();
+    for (const auto& name : Assets::List(charactersDir_, ".json")) {
+        std::string id = std::filesystem::path(name).stem().string();
+        index_.emplace(id, ids_.size());
+        ids_.push_back(std::move(id));
+    }
+    return ids_.size();
+}
+
+const std::vector<std::string>& CharacterRoster::Ids() const {
+    return ids_;
+}
+
+bool CharacterRoster::Contains(const std::string& id) const {
+    return index_.count(id) > 0;
+}
+
+std::shared_ptr<const CharacterAssets> CharacterRoster::Acquire(const std::string& id) {
+    auto it = resident_.find(id);
+    if (it != resident_.end()) {
+        recency_.splice(recency_.begin(), recency_, it->second.recency);
+        ReleaseDropped();
+        return it->second.assets;
+    }
+    if (!Contains(id)) return nullptr;
+
+    std::vector<std::string> sources;
+    std::shared_ptr<CharacterAssets> assets = Load(id, sources);
+    if (!assets) {
+        ReleaseDropped();
+        return nullptr;
+    }
+
+    for (const auto& source : sources) ++sourceUsers_[source];
+    recency_.push_front(id);
+    resident_.emplace(id, Resident{assets, recency_.begin(), std::move(sources)});
+    residentBytes_ += assets->footprint;
+    ReleaseDropped();
+    EvictCold();
+    return assets;
+}
+
+std::size_t CharacterRoster::ResidentBytes() const {
+    return residentBytes_;
+}
+
+std::shared_ptr<CharacterAssets> CharacterRoster::Load(const std::string& id, std::vector<std::string>& sources) {
+    std::string personaFile = JoinPath(charactersDir_, id + ".json");
+    auto persona = personaCache_.Get(personaFile, [](const std::string& path, const std::string* contents) {
+        auto data = std::make_shared<nlohmann::json>();
+        bool ok = contents ? ParseJsonText(path, *contents, *data) : Assets::LoadJson(path, *data);
+        if (!ok || !data->is_object()) return std::shared_ptr<const nlohmann::json>();
+        return std::shared_ptr<const nlohmann::json>(std::move(data));
+    });
+    if (!persona) {
+        std::cerr << "[CharacterRoster] 캐릭터를 불러올 수 없습니다: " << id << '\n';
+        return nullptr;
+    }
+    sources.push_back(personaFile);
+    const nlohmann::json& data = *persona;
+
+    auto assets = std::make_shared<CharacterAssets>();
+    assets->persona = data.get<Character>(); // 누락된 키는 JSON 변환 과정에서 기본값으로 처리됨
+    assets->persona.SetId(id);
+    if (!data.contains("affection") && !data.contains("initialAffection")) {
+        assets->persona.SetAffection(defaultAffection_);
+    }
+
+    // 표가 없거나 잘못되었으면 기본 단계 구성을 씁니다.
+    if (data.contains("affectionToStage") && !assets->stages.Load(data["affectionToStage"])) {
+        std::cerr << "[CharacterRoster] 기본 단계 구성을 사용합니다: " << id << '\n';
+    }
+
+    // 캐릭터 전용 프롬프트가 없으면 공용 프롬프트를 씁니다.
+    auto loadText = [](const std::string& path, const std::string* contents) {
+        if (contents) return std::shared_ptr<const std::string>(std::make_shared<std::string>(*contents));
+        auto text = std::make_shared<std::string>();
+        if (!Assets::LoadText(path, *text)) return std::shared_ptr<const std::string>();
+        return std::shared_ptr<const std::string>(std::move(text));
+    };
+    const std::string ownDir = JoinPath(JoinPath(charactersDir_, id), "prompts");
+    const std::string sharedDir = JoinPath(charactersDir_, "prompts");
+    assets->stagePrompts.resize(static_cast<std::size_t>(assets->stages.StageCount()));
+    for (int stage = 0; stage < assets->stages.StageCount(); ++stage) {
+        std::string file = "stage_" + std::to_string(stage) + ".txt";
+        std::string promptFile = JoinPath(ownDir, file);
+        auto prompt = promptCache_.Get(promptFile, loadText);
+        if (!prompt) {
+            promptFile = JoinPath(sharedDir, file);
+            prompt = promptCache_.Get(promptFile, loadText);
+        }
+        if (!prompt) continue;
+        sources.push_back(promptFile);
+        assets->stagePrompts[static_cast<std::size_t>(stage)] = *prompt;
+    }
+
+    std::string eventsFile = JoinPath(JoinPath(charactersDir_, id), "events.json");
+    if (!Assets::Exists(eventsFile)) eventsFile = sharedEventsFile_;
+    assets->events = eventCache_.Get(eventsFile, [](const std::string& path, const std::string* contents) {
+        std::vector<Event> events;
+        if (!LoadEventPack(path, contents, events)) return std::shared_ptr<const EventEngine>();
+        return std::shared_ptr<const EventEngine>(std::make_shared<EventEngine>(std::move(events)));
+    });
+    if (assets->events) {
+        sources.push_back(eventsFile);
+    } else {
+        assets->events = std::make_shared<EventEngine>();
+    }
+
+    assets->footprint = EstimateFootprint(*assets);
+    return assets;
+}
+
+std::vector<std::string> CharacterRoster::WatchDirectories() const {
+    std::vector<std::string> directories{charactersDir_, JoinPath(charactersDir_, "prompts")};
+    for (const auto& id : ids_) {
+        directories.push_back(JoinPath(charactersDir_, id));
+        directories.push_back(JoinPath(JoinPath(charactersDir_, id), "prompts"));
+    }
+    directories.push_back(std::filesystem::path(sharedEventsFile_).parent_path().generic_string());
+    return directories;
+}
+
+std::vector<std::string> CharacterRoster::OnContentChanged(const std::vector<std::string>& paths) {
+    namespace fs = std::filesystem;
+    const fs::path root = fs::path(charactersDir_).lexically_normal();
+    const fs::path sharedEvents = fs::path(sharedEventsFile_).lexically_normal();
+
+    std::vector<std::string> affected;
+    bool everyone = false;
+    bool rescan = false;
+    for (const auto& changed : paths) {
+        fs::path path = fs::path(changed).lexically_normal();
+        if (path == sharedEvents) {
+            everyone = true;
+            continue;
+        }
+        fs::path relative = path.lexically_relative(root);
+        if (relative.empty() || *relative.begin() == "..") continue;
+
+        std::string head = relative.begin()->string();
+        if (std::distance(relative.begin(), relative.end()) == 1) {
+            // 캐릭터 파일(<id>.json) 자체가 바뀜
+            if (relative.extension() != ".json") continue;
+            std::string id = relative.stem().string();
+            if (!Contains(id) || !Assets::Exists(changed)) rescan = true;
+            affected.push_back(id);
+        } else if (head == "prompts") {
+            everyone = true;  // 공용 프롬프트
+        } else {
+            affected.push_back(head);  // <id>/prompts/..., <id>/events.json
+        }
+    }
+    if (rescan) Scan();
+    if (everyone) {
+        for (const auto& [id, resident] : resident_) affected.push_back(id);
+    }
+
+    std::sort(affected.begin(), affected.end());
+    affected.erase(std::unique(affected.begin(), affected.end()), affected.end());
+    for (const auto& id : affected) Drop(id);
+    return affected;
+}
+
+void CharacterRoster::Drop(const std::string& id) {
+    auto it = resident_.find(id);
+    if (it == resident_.end()) return;
+    residentBytes_ -= it->second.assets->footprint;
+    recency_.erase(it->second.recency);
+    // 곧 다시 불러올 때 바뀌지 않은 파일의 파싱 결과를 다시 쓰도록, 캐시는 다음 Acquire가 끝난 뒤에 놓습니다.
+    for (auto& source : it->second.sources) dropped_.push_back(std::move(source));
+    resident_.erase(it);
+}
+
+void CharacterRoster::EvictCold() {
+    // 가장 오래 쓰지 않은 캐릭터부터 내보냅니다. 게임이 붙잡고 있는 에셋은 남겨둡니다.
+    auto it = recency_.end();
+    while (residentBytes_ > capBytes_ && it != recency_.begin()) {
+        --it;
+        auto found = resident_.find(*it);
+        if (found->second.assets.use_count() > 1) continue;
+        residentBytes_ -= found->second.assets->footprint;
+        Release(found->second.sources);
+        resident_.erase(found);
+        it = recency_.erase(it);
+    }
+}
+
+void CharacterRoster::ReleaseDropped() {
+    std::vector<std::string> dropped = std::move(dropped_);
+    dropped_.clear();
+    Release(dropped);
+}
+
+void CharacterRoster::Release(const std::vector<std::string>& sources) {
+    // 남은 캐릭터가 아무도 쓰지 않는 파일만 캐시에서 내립니다. (공용 프롬프트·이벤트는 함께 쓰는 동안 유지)
+    for (const auto& source : sources) {
+        auto it = sourceUsers_.find(source);
+        if (it == sourceUsers_.end() || --it->second > 0) continue;
+        sourceUsers_.erase(it);
+        personaCache_.Erase(source);
+        promptCache_.Erase(source);
+        eventCache_.Erase(source);
+    }
+}
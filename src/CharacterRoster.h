@@ -0,0 +1,100 @@
+#pragma once
+
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Character.h"
+#include "ContentCache.h"
+#include "EventEngine.h"
+#include "StageTable.h"
+
+class Config;
+
+/**
+ * 캐릭터 한 명이 대화에 필요한 에셋 묶음입니다. 로스터가 처음 요청될 때 만듭니다.
+ */
+struct CharacterAssets {
+    Character persona;                       // 새 게임을 시작할 때의 초기 상태
+    StageTable stages;                       // 호감도 → 관계 단계
+    std::vector<std::string> stagePrompts;   // 관계 단계별 행동 지침 (없는 단계는 빈 문자열)
+    std::shared_ptr<const EventEngine> events;  // 임계값 순으로 정렬된 이벤트 (같은 파일을 쓰는 캐릭터끼리 공유)
+    std::size_t footprint = 0;               // 대략적인 메모리 사용량(바이트)
+
+    // 단계에 맞는 프롬프트를 반환합니다. 없으면 빈 문자열을 반환합니다.
+    const std::string& StagePrompt(int stage) const;
+};
+
+/**
+ * `charactersDir`의 캐릭터 파일(`<id>.json`)을 id로 색인하는 로스터입니다.
+ *
+ * 시작할 때는 파일 이름만 훑고, 페르소나·단계 프롬프트·이벤트는 캐릭터를 처음 고를 때 읽습니다.
+ * 캐릭터별 에셋은 `<id>/prompts/stage_N.txt`, `<id>/events.json`에 두며, 없으면 공용 파일을 씁니다.
+ * 메모리 상한을 넘으면 가장 오래 쓰지 않은 캐릭터부터 내보냅니다. (사용 중인 캐릭터는 제외)
+ *
+ * 파일별 파싱 결과는 ContentCache에 두므로 다시 불러올 때 바뀐 파일만 읽습니다.
+ * 캐시 항목은 그 파일을 쓰는 캐릭터가 메모리에 있는 동안만 유지하며, 마지막 캐릭터가 내보내지면 함께 내립니다.
+ * 파일이 바뀌면 해당 캐릭터의 에셋을 내려두고, 다음 Acquire에서 새 에셋을 만듭니다.
+ * 이전 에셋을 쥐고 있던 쪽은 새 에셋으로 바꿔 쥘 때까지 그대로 쓸 수 있습니다.
+ */
+class CharacterRoster {
+public:
+    explicit CharacterRoster(const Config& config);
+
+    // 캐릭터 디렉토리를 훑어 id 목록을 만들고 캐릭터 수를 반환합니다. 파일 내용은 읽지 않습니다.
+    std::size_t Scan();
+
+    // id 목록을 정렬된 순서로 반환합니다.
+    const std::vector<std::string>& Ids() const;
+
+    // 해당 id의 캐릭터가 있는지 반환합니다.
+    bool Contains(const std::string& id) const;
+
+    // 캐릭터 에셋을 반환합니다. 메모리에 없으면 읽어들이며, 실패하면 nullptr을 반환합니다.
+    std::shared_ptr<const CharacterAssets> Acquire(const std::string& id);
+
+    // 현재 메모리에 올라와 있는 에셋의 대략적인 크기(바이트)를 반환합니다.
+    std::size_t ResidentBytes() const;
+
+    // 변경 감시가 필요한 디렉토리 목록을 반환합니다. (캐릭터 디렉토리, 공용 프롬프트, 캐릭터별 디렉토리, 이벤트 파일 위치)
+    std::vector<std::string> WatchDirectories() const;
+
+    // 바뀐 파일 경로를 받아 영향을 받는 캐릭터의 에셋을 내려두고 그 id 목록을 반환합니다.
+    // 캐릭터 파일이 추가되거나 지워졌으면 id 목록도 다시 만듭니다.
+    std::vector<std::string> OnContentChanged(const std::vector<std::string>& paths);
+
+private:
+    struct Resident {
+        std::shared_ptr<const CharacterAssets> assets;
+        std::list<std::string>::iterator recency;
+        std::vector<std::string> sources;  // 에셋을 만들 때 캐시에서 가져온 파일 경로
+    };
+
+    // 에셋을 만들고, 캐시에서 가져온 파일 경로를 `sources`에 덧붙입니다.
+    std::shared_ptr<CharacterAssets> Load(const std::string& id, std::vector<std::string>& sources);
+    void Drop(const std::string& id);
+    void EvictCold();
+    void ReleaseDropped();
+    void Release(const std::vector<std::string>& sources);
+
+    std::string charactersDir_;
+    std::string sharedEventsFile_;
+    int defaultAffection_;
+    std::size_t capBytes_;
+
+    std::vector<std::string> ids_;
+    std::unordered_map<std::string, std::size_t> index_;
+
+    ContentCache<nlohmann::json> personaCache_;
+    ContentCache<std::string> promptCache_;
+    ContentCache<EventEngine> eventCache_;
+
+    std::unordered_map<std::string, Resident> resident_;
+    std::list<std::string> recency_;  // 앞쪽이 최근에 쓴 캐릭터
+    std::size_t residentBytes_;
+
+    std::unordered_map<std::string, std::size_t> sourceUsers_;  // 파일 경로 → 그 파일을 쓰는 상주 캐릭터 수
+    std::vector<std::string> dropped_;  // Drop한 캐릭터가 쓰던 파일 (다음 Acquire 뒤에 놓음)
+};
@@ -0,0 +1,422 @@
+#include "ChunkStore.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <unordered_set>
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#include "FileIO.h"
+
+namespace {
+constexpr std::size_t kMinChunk = 2 * 1024;
+constexpr std::size_t kMaxChunk = 64 * 1024;
+// 상위 13비트를 검사합니다. Gear 해시의 상위 비트는 최근 64바이트 전체에 의존합니다. (평균 8 KiB)
+constexpr std::uint64_t kBoundaryMask = ~(~0ull >> 13);
+
+constexpr char kCodecRaw = 0;
+constexpr char kCodecDeflate = 1;
+
+// 팩 파일: [매직 "ITCK"(4)][청크 수(4)][항목: 해시(8) CRC(4) 크기(4) 오프셋(8) 길이(4) × N][청크 본문...]
+constexpr char kPackMagic[4] = {'I', 'T', 'C', 'K'};
+constexpr std::size_t kPackHeaderSize = 8;
+constexpr std::size_t kPackEntrySize = 28;
+
+struct PackEntry {
+    ChunkRef ref;
+    std::uint64_t offset = 0;  // 파일 처음부터의 위치
+    std::uint32_t length = 0;  // 인코딩된 본문 길이
+};
+
+template <typename T>
+void PutRaw(std::string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+T TakeRaw(const char* in) {
+    T value;
+    std::memcpy(&value, in, sizeof(T));
+    return value;
+}
+
+std::array<std::uint64_t, 256> BuildGearTable() {
+    // 결정적인 의사 난수(splitmix64)로 채워 어느 빌드에서도 같은 경계를 얻습니다.
+    std::array<std::uint64_t, 256> table{};
+    std::uint64_t state = 0x9E3779B97F4A7C15ull;
+    for (auto& value : table) {
+        state += 0x9E3779B97F4A7C15ull;
+        std::uint64_t z = state;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        value = z ^ (z >> 31);
+    }
+    return table;
+}
+
+std::uint64_t Fnv1a64(std::string_view data) {
+    std::uint64_t hash = 0xCBF29CE484222325ull;
+    for (unsigned char ch : data) {
+        hash ^= ch;
+        hash *= 0x100000001B3ull;
+    }
+    return hash;
+}
+
+ChunkRef MakeRef(std::string_view chunk) {
+    ChunkRef ref;
+    ref.hash = Fnv1a64(chunk);
+    ref.crc = FileIO::Crc32(chunk);
+    ref.size = static_cast<std::uint32_t>(chunk.size());
+    return ref;
+}
+
+std::string NameOf(const ChunkRef& ref) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx%08x",
+                  static_cast<unsigned long long>(ref.hash), static_cast<unsigned>(ref.crc));
+    return name;
+}
+
+// 팩의 항목 표를 읽습니다. 본문이 파일 밖을 가리키면 false를 반환합니다.
+bool ReadPackTable(std::string_view file, std::vector<PackEntry>& entries) {
+    entries.clear();
+    if (file.size() < kPackHeaderSize || std::memcmp(file.data(), kPackMagic, sizeof(kPackMagic)) != 0) return false;
+    auto count = TakeRaw<std::uint32_t>(file.data() + 4);
+    if ((file.size() - kPackHeaderSize) / kPackEntrySize < count) return false;
+    entries.resize(count);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        const char* raw = file.data() + kPackHeaderSize + i * kPackEntrySize;
+        PackEntry& entry = entries[i];
+        entry.ref.hash = TakeRaw<std::uint64_t>(raw);
+        entry.ref.crc = TakeRaw<std::uint32_t>(raw + 8);
+        entry.ref.size = TakeRaw<std::uint32_t>(raw + 12);
+        entry.offset = TakeRaw<std::uint64_t>(raw + 16);
+        entry.length = TakeRaw<std::uint32_t>(raw + 24);
+        if (entry.offset > file.size() || entry.length > file.size() - entry.offset) return false;
+    }
+    return true;
+}
+
+// 인코딩된 청크 본문들을 팩 하나로 묶고, 항목 표의 해시로 지은 파일 이름을 `name`에 돌려줍니다.
+std::string BuildPack(const std::vector<ChunkRef>& refs, const std::vector<std::string>& bodies, std::string& name) {
+    std::string table;
+    std::uint64_t offset = kPackHeaderSize + refs.size() * kPackEntrySize;
+    for (std::size_t i = 0; i < refs.size(); ++i) {
+        PutRaw(table, refs[i].hash);
+        PutRaw(table, refs[i].crc);
+        PutRaw(table, refs[i].size);
+        PutRaw(table, offset);
+        PutRaw(table, static_cast<std::uint32_t>(bodies[i].size()));
+        offset += bodies[i].size();
+    }
+
+    char file[32];
+    std::snprintf(file, sizeof(file), "%016llx.pack", static_cast<unsigned long long>(Fnv1a64(table)));
+    name = file;
+
+    std::string pack;
+    pack.reserve(static_cast<std::size_t>(offset));
+    pack.append(kPackMagic, sizeof(kPackMagic));
+    PutRaw(pack, static_cast<std::uint32_t>(refs.size()));
+    pack += table;
+    for (const auto& body : bodies) pack += body;
+    return pack;
+}
+
+void Encode(std::string_view chunk, bool compress, std::string& out) {
+    out.clear();
+#ifdef HAVE_ZLIB
+    if (compress) {
+        uLongf bound = compressBound(static_cast<uLong>(chunk.size()));
+        out.resize(1 + bound);
+        out[0] = kCodecDeflate;
+        if (compress2(reinterpret_cast<Bytef*>(&out[1]), &bound,
+                      reinterpret_cast<const Bytef*>(chunk.data()), static_cast<uLong>(chunk.size()),
+                      Z_DEFAULT_COMPRESSION) == Z_OK &&
+            bound < chunk.size()) {
+            out.resize(1 + bound);
+            return;
+        }
+        // 압축이 이득이 없으면 원본 그대로 저장합니다.
+    }
+#else
+    (void)compress;
+#endif
+    out.reserve(1 + chunk.size());
+    out.push_back(kCodecRaw);
+    out.append(chunk.data(), chunk.size());
+}
+
+bool Decode(std::string_view stored, std::uint32_t size, std::string& out) {
+    if (stored.empty()) return false;
+    std::string_view payload = stored.substr(1);
+    if (stored[0] == kCodecRaw) {
+        out.append(payload.data(), payload.size());
+        return payload.size() == size;
+    }
+#ifdef HAVE_ZLIB
+    if (stored[0] == kCodecDeflate) {
+        std::size_t base = out.size();
+        out.resize(base + size);
+        uLongf length = size;
+        if (uncompress(reinterpret_cast<Bytef*>(&out[base]), &length,
+                       reinterpret_cast<const Bytef*>(payload.data()), static_cast<uLong>(payload.size())) != Z_OK ||
+            length != size) {
+            out.resize(base);
+            return false;
+        }
+        return true;
+    }
+#endif
+    std::cerr << "[ChunkStore] 지원하지 않는 압축 형식입니다: " << static_cast<int>(stored[0]) << '\n';
+    return false;
+}
+}  // 익명 네임스페이스 종료
+
+ChunkStore::ChunkStore(std::string directory, bool compress)
+    : directory_(std::move(directory)),
+      compress_(compress) {
+#ifndef HAVE_ZLIB
+    if (compress_) {
+        std::cerr << "[ChunkStore] zlib 없이 빌드되어 청크를 압축하지 않습니다.\n";
+        compress_ = false;
+    }
+#endif
+}
+
+std::vector<std::string_view> ChunkStore::Split(std::string_view data) {
+    static const std::array<std::uint64_t, 256> gear = BuildGearTable();
+
+    std::vector<std::string_view> chunks;
+    std::size_t start = 0;
+    while (start < data.size()) {
+        std::size_t remaining = data.size() - start;
+        std::size_t end = start + std::min(remaining, kMaxChunk);
+        std::size_t cut = end;
+        if (remaining > kMinChunk) {
+            std::uint64_t hash = 0;
+            for (std::size_t i = start + kMinChunk; i < end; ++i) {
+                hash = (hash << 1) + gear[static_cast<unsigned char>(data[i])];
+                if ((hash & kBoundaryMask) == 0) {
+                    cut = i + 1;
+                    break;
+                }
+            }
+        }
+        chunks.push_back(data.substr(start, cut - start));
+        start = cut;
+    }
+    return chunks;
+}
+
+bool ChunkStore::Put(std::string_view data, std::vector<ChunkRef>& refs) {
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    fs::create_directories(directory_, ec);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    LoadIndexLocked();
+
+    // 이전 세대가 이미 기록한 청크는 다시 쓰지 않고, 새 청크만 모아 팩 하나로 씁니다.
+    refs.clear();
+    std::vector<ChunkRef> added;
+    std::vector<std::string> bodies;
+    std::unordered_set<std::string> pending;
+    for (std::string_view chunk : Split(data)) {
+        ChunkRef ref = MakeRef(chunk);
+        refs.push_back(ref);
+
+        std::string name = NameOf(ref);
+        if (index_.count(name) || !pending.insert(name).second) continue;
+        added.push_back(ref);
+        bodies.emplace_back();
+        Encode(chunk, compress_, bodies.back());
+    }
+    if (added.empty()) return true;
+
+    std::string packName;
+    std::string pack = BuildPack(added, bodies, packName);
+    std::string path = (fs::path(directory_) / packName).string();
+    if (!FileIO::ReplaceAtomic(path, pack)) {
+        std::cerr << "[ChunkStore] 청크 기록 실패: " << path << '\n';
+        return false;
+    }
+
+    std::uint64_t offset = kPackHeaderSize + added.size() * kPackEntrySize;
+    for (std::size_t i = 0; i < added.size(); ++i) {
+        index_[NameOf(added[i])] = Location{path, offset, static_cast<std::uint32_t>(bodies[i].size())};
+        offset += bodies[i].size();
+    }
+    return true;
+}
+
+bool ChunkStore::Get(const std::vector<ChunkRef>& refs, std::string& out) const {
+    out.clear();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        LoadIndexLocked();
+    }
+
+    // 한 세이브의 청크는 대개 몇 개의 팩에 몰려 있으므로 연 팩은 호출 동안 열어 둡니다.
+    std::unordered_map<std::string, std::unique_ptr<MappedFile>> packs;
+    std::string loose;
+    for (const ChunkRef& ref : refs) {
+        std::string name = NameOf(ref);
+        Location location;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = index_.find(name);
+            if (it == index_.end()) {
+                std::cerr << "[ChunkStore] 청크를 찾을 수 없습니다: " << name << '\n';
+                return false;
+            }
+            location = it->second;
+        }
+
+        std::string_view stored;
+        if (location.pack.empty()) {
+            if (!FileIO::ReadAll(PathFor(name), loose)) {
+                std::cerr << "[ChunkStore] 청크를 찾을 수 없습니다: " << name << '\n';
+                return false;
+            }
+            stored = loose;
+        } else {
+            auto& pack = packs[location.pack];
+            if (!pack) {
+                pack = std::make_unique<MappedFile>();
+                if (!pack->Open(location.pack)) {
+                    std::cerr << "[ChunkStore] 팩을 열 수 없습니다: " << location.pack << '\n';
+                    return false;
+                }
+            }
+            std::string_view file = pack->View();
+            if (location.offset > file.size() || location.length > file.size() - location.offset) {
+                std::cerr << "[ChunkStore] 팩이 잘렸습니다: " << location.pack << '\n';
+                return false;
+            }
+            stored = file.substr(static_cast<std::size_t>(location.offset), location.length);
+        }
+
+        std::size_t base = out.size();
+        if (!Decode(stored, ref.size, out)) {
+            std::cerr << "[ChunkStore] 청크가 손상되었습니다: " << name << '\n';
+            return false;
+        }
+        std::string_view chunk = std::string_view(out).substr(base);
+        if (FileIO::Crc32(chunk) != ref.crc || Fnv1a64(chunk) != ref.hash) {
+            std::cerr << "[ChunkStore] 청크 체크섬이 맞지 않습니다: " << name << '\n';
+            return false;
+        }
+    }
+    return true;
+}
+
+std::size_t ChunkStore::Collect(const std::vector<ChunkRef>& live) {
+    namespace fs = std::filesystem;
+    std::unordered_set<std::string> marked;
+    for (const ChunkRef& ref : live) marked.insert(NameOf(ref));
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::error_code ec;
+    if (!fs::exists(directory_, ec)) return 0;
+
+    // 같은 청크가 여러 곳에 있으면 처음 만난 것만 남깁니다.
+    std::unordered_set<std::string> kept;
+    std::size_t removed = 0;
+    std::vector<fs::path> packs;
+    for (const auto& file : fs::directory_iterator(directory_, ec)) {
+        if (!file.is_regular_file()) continue;
+        if (file.path().extension() == ".pack") {
+            packs.push_back(file.path());
+            continue;
+        }
+        if (file.path().extension() != ".chk") continue;
+        std::string name = file.path().stem().string();
+        if (marked.count(name) && kept.insert(name).second) continue;
+        fs::remove(file.path(), ec);
+        ++removed;
+    }
+
+    for (const auto& path : packs) {
+        std::vector<ChunkRef> refs;
+        std::vector<std::string> bodies;
+        std::size_t total = 0;
+        {
+            MappedFile file;
+            std::vector<PackEntry> entries;
+            if (!file.Open(path.string()) || !ReadPackTable(file.View(), entries)) {
+                // 읽을 수 없는 팩은 살아 있는 청크를 담고 있을 수 있으므로 건드리지 않습니다.
+                std::cerr << "[ChunkStore] 팩을 읽을 수 없어 정리에서 뺍니다: " << path.string() << '\n';
+                continue;
+            }
+            total = entries.size();
+            for (const auto& entry : entries) {
+                std::string name = NameOf(entry.ref);
+                if (!marked.count(name) || !kept.insert(name).second) continue;
+                refs.push_back(entry.ref);
+                bodies.emplace_back(file.View().substr(static_cast<std::size_t>(entry.offset), entry.length));
+            }
+        }
+        if (refs.size() == total) continue;
+
+        // 살아 있는 청크가 남은 팩은 그 청크만으로 새 팩을 쓴 뒤에 옛 팩을 지웁니다.
+        if (!refs.empty()) {
+            std::string packName;
+            std::string pack = BuildPack(refs, bodies, packName);
+            fs::path rewritten = path.parent_path() / packName;
+            if (!FileIO::ReplaceAtomic(rewritten.string(), pack)) {
+                std::cerr << "[ChunkStore] 팩 재작성 실패: " << rewritten.string() << '\n';
+                continue;
+            }
+            if (rewritten == path) continue;
+        }
+        fs::remove(path, ec);
+        removed += total - refs.size();
+    }
+
+    FileIO::SyncDirectory(directory_);
+    // 위치가 바뀌었으므로 다음에 필요할 때 다시 훑습니다.
+    index_.clear();
+    indexed_ = false;
+    return removed;
+}
+
+void ChunkStore::LoadIndexLocked() const {
+    if (indexed_) return;
+    indexed_ = true;
+    index_.clear();
+
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    if (!fs::exists(directory_, ec)) return;
+    std::vector<PackEntry> entries;
+    for (const auto& file : fs::directory_iterator(directory_, ec)) {
+        if (!file.is_regular_file()) continue;
+        std::string path = file.path().string();
+        if (file.path().extension() == ".chk") {
+            index_.emplace(file.path().stem().string(), Location{});
+            continue;
+        }
+        if (file.path().extension() != ".pack") continue;
+        MappedFile pack;
+        if (!pack.Open(path) || !ReadPackTable(pack.View(), entries)) {
+            std::cerr << "[ChunkStore] 팩이 손상되었습니다: " << path << '\n';
+            continue;
+        }
+        for (const auto& entry : entries) {
+            index_.emplace(NameOf(entry.ref), Location{path, entry.offset, entry.length});
+        }
+    }
+}
+
+std::string ChunkStore::PathFor(const std::string& name) const {
+    return (std::filesystem::path(directory_) / (name + ".chk")).string();
+}
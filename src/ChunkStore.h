@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * 내용 기반 청크 하나를 가리키는 참조입니다. 세이브 파일에는 이 참조 목록만 기록됩니다.
+ */
+struct ChunkRef {
+    std::uint64_t hash = 0;   // FNV-1a 64비트
+    std::uint32_t crc = 0;    // CRC-32 (해시와 함께 청크 이름을 이룹니다)
+    std::uint32_t size = 0;   // 압축 전 크기
+};
+
+/**
+ * 세이브 간에 공유되는 내용 주소 기반(content-addressed) 청크 저장소입니다.
+ * 데이터를 롤링 해시(Gear)로 내용에 따라 나누므로, 앞부분이 같은 대화 기록은
+ * 세이브 세대가 달라도 같은 청크로 나뉘어 한 번만 저장됩니다.
+ * 한 번의 저장에서 새로 생긴 청크는 팩 파일 `<directory>/<해시>.pack` 하나에 모아 쓰므로 fsync도 한 번입니다.
+ * 각 청크 본문의 첫 바이트는 압축 방식을 나타냅니다. (이전 버전의 낱개 `<해시>.chk` 파일도 읽습니다)
+ */
+class ChunkStore {
+public:
+    // `compress`가 true이고 zlib과 함께 빌드된 경우 새 청크를 deflate로 압축합니다.
+    ChunkStore(std::string directory, bool compress);
+
+    // 데이터를 청크로 나누어 없는 청크만 팩 하나로 기록하고 참조 목록을 `refs`에 돌려줍니다.
+    bool Put(std::string_view data, std::vector<ChunkRef>& refs);
+
+    // 참조 목록의 청크를 순서대로 읽어 이어 붙입니다. 청크가 없거나 손상되면 false를 반환합니다.
+    bool Get(const std::vector<ChunkRef>& refs, std::string& out) const;
+
+    // `live`에 없는 청크를 지웁니다. (마크 앤 스윕) 살아 있는 청크가 섞인 팩은 그 청크만으로 다시 씁니다.
+    // `live`에는 디스크에 남은 모든 세이브의 참조가 들어 있어야 하며, 지운 청크 수를 반환합니다.
+    std::size_t Collect(const std::vector<ChunkRef>& live);
+
+    // 내용 기반 경계로 데이터를 나눕니다. (최소 2 KiB, 평균 약 8 KiB, 최대 64 KiB)
+    static std::vector<std::string_view> Split(std::string_view data);
+
+private:
+    // 청크 본문의 위치입니다. `pack`이 비어 있으면 낱개 `.chk` 파일 전체가 본문입니다.
+    struct Location {
+        std::string pack;
+        std::uint64_t offset = 0;
+        std::uint32_t length = 0;
+    };
+
+    // 팩과 낱개 청크를 훑어 청크 이름별 위치를 만듭니다. (mutex_를 잡은 채 호출)
+    void LoadIndexLocked() const;
+    std::string PathFor(const std::string& name) const;
+
+    std::string directory_;
+    bool compress_;
+
+    // 디스크에 있는 청크의 위치 (처음 필요할 때 한 번 훑음)
+    mutable std::mutex mutex_;
+    mutable bool indexed_ = false;
+    mutable std::unordered_map<std::string, Location> index_;
+};
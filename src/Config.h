@@ -1,28 +1,44 @@
 #pragma once
 
+#include <algorithm>
 #include <string>
 #include <cstdlib>
 
-#include "JsonHelper.h"
+#include "AssetBundle.h"
 
 /**
  * JSON 파일에서 런타임 설정을 로드하고 저장하는 클래스입니다.
  */
 class Config {
 public:
+    // 한 턴에 동시에 요청할 수 있는 후보 응답 수의 상한 (후보마다 스레드와 연결을 하나씩 씁니다)
+    static constexpr int kMaxCandidateCount = 4;
+
     // 기본 설정값으로 초기화합니다.
     Config()
         : model_("gpt-5"),
           historyLimit_(5),
+          historyWindow_(200),
           charactersDir_("data/characters"),
           eventsFile_("data/events/template_events.json"),
           savesDir_("saves"),
-          defaultInitialAffection_(10) {}
+          saveMode_("snapshot"),
+          saveFormat_("json"),
+          saveCompression_("deflate"),
+          journalCompactEvery_(256),
+          defaultInitialAffection_(10),
+          candidateCount_(1),
+          candidateDeadlineMs_(8000),
+          rosterMemoryCapKb_(4096),
+          typingCharsPerSecond_(50),
+          typingFrameRate_(60),
+          autosaveIntervalSeconds_(0),
+          statusBar_(true) {}
 
     // 지정된 JSON 파일에서 설정을 로드합니다.
     bool Load(const std::string& path) {
         nlohmann::json data;
-        if (!JsonHelper::LoadFromFile(path, data)) {
+        if (!Assets::LoadJson(path, data)) {
             return false;
         }
 
@@ -36,6 +52,11 @@ public:
                 target = data[key].get<int>();
             }
         };
+        auto assign_bool = [&](const char* key, bool& target) {
+            if (data.contains(key) && data[key].is_boolean()) {
+                target = data[key].get<bool>();
+            }
+        };
 
         assign_string("model", model_);
         
@@ -48,10 +69,24 @@ public:
         }
 
         assign_int("historyLimit", historyLimit_);
+        assign_int("historyWindow", historyWindow_);
         assign_string("charactersDir", charactersDir_);
         assign_string("eventsFile", eventsFile_);
         assign_string("savesDir", savesDir_);
+        assign_string("saveMode", saveMode_);
+        assign_string("saveFormat", saveFormat_);
+        assign_string("saveCompression", saveCompression_);
+        assign_int("journalCompactEvery", journalCompactEvery_);
         assign_int("defaultInitialAffection", defaultInitialAffection_);
+        assign_int("candidateCount", candidateCount_);
+        assign_int("candidateDeadlineMs", candidateDeadlineMs_);
+        candidateCount_ = std::clamp(candidateCount_, 1, kMaxCandidateCount);
+        candidateDeadlineMs_ = std::max(candidateDeadlineMs_, 0);
+        assign_int("rosterMemoryCapKb", rosterMemoryCapKb_);
+        assign_int("typingCharsPerSecond", typingCharsPerSecond_);
+        assign_int("typingFrameRate", typingFrameRate_);
+        assign_int("autosaveIntervalSeconds", autosaveIntervalSeconds_);
+        assign_bool("statusBar", statusBar_);
         return true;
     }
 
@@ -64,6 +99,9 @@ public:
     // 대화 히스토리 제한(턴 수)을 반환합니다.
     int GetHistoryLimit() const { return historyLimit_; }
 
+    // 메모리에 유지할 최근 대화 턴 수를 반환합니다. 넘치는 턴은 디스크로 내보냅니다. (0이면 무제한)
+    int GetHistoryWindow() const { return historyWindow_; }
+
     // 캐릭터 데이터의 기본 디렉토리를 반환합니다.
     const std::string& GetCharactersDir() const { return charactersDir_; }
 
@@ -73,9 +111,42 @@ public:
     // 세이브 디렉토리를 반환합니다.
     const std::string& GetSavesDir() const { return savesDir_; }
 
+    // 저장 방식을 반환합니다. ("snapshot": 매번 전체 저장, "journal": 기본 스냅샷 + 추가 전용 저널)
+    const std::string& GetSaveMode() const { return saveMode_; }
+
+    // 세이브 파일 형식을 반환합니다. ("json": 텍스트 JSON, "binary": 헤더+오프셋 테이블을 가진 MessagePack)
+    const std::string& GetSaveFormat() const { return saveFormat_; }
+
+    // 바이너리 세이브 청크의 압축 방식을 반환합니다. ("deflate" 또는 "none")
+    const std::string& GetSaveCompression() const { return saveCompression_; }
+
+    // 저널 레코드가 이 수를 넘으면 기본 스냅샷으로 압축(compaction)합니다.
+    int GetJournalCompactEvery() const { return journalCompactEvery_; }
+
     // 캐릭터별 설정이 없을 경우 사용할 기본 초기 호감도를 반환합니다.
     int GetDefaultInitialAffection() const { return defaultInitialAffection_; }
 
+    // 한 턴에 요청할 후보 응답 수를 반환합니다. (1이면 단일 응답, 최대 kMaxCandidateCount)
+    int GetCandidateCount() const { return candidateCount_; }
+
+    // 후보 응답을 기다릴 최대 시간(ms)을 반환합니다.
+    int GetCandidateDeadlineMs() const { return candidateDeadlineMs_; }
+
+    // 로스터가 메모리에 유지할 캐릭터 에셋의 상한(KB)을 반환합니다.
+    int GetRosterMemoryCapKb() const { return rosterMemoryCapKb_; }
+
+    // 타자 효과의 초당 글자 수를 반환합니다. (0이면 즉시 출력)
+    int GetTypingCharsPerSecond() const { return typingCharsPerSecond_; }
+
+    // 타자 효과를 화면에 내보내는 초당 프레임 수를 반환합니다.
+    int GetTypingFrameRate() const { return typingFrameRate_; }
+
+    // 대화 중 자동 저장 간격(초)을 반환합니다. (0이면 자동 저장하지 않음)
+    int GetAutosaveIntervalSeconds() const { return autosaveIntervalSeconds_; }
+
+    // 채팅 화면 맨 위에 상태 표시줄(모델, 응답 속도, 토큰 수, 호감도)을 보여줄지 반환합니다.
+    bool GetStatusBar() const { return statusBar_; }
+
     // LLM 서비스용 API 키를 반환합니다.
     const std::string& GetApiKey() const { return apiKey_; }
 
@@ -83,9 +154,21 @@ private:
     std::string model_;
     std::string apiKey_;
     int historyLimit_;
+    int historyWindow_;
 
     std::string charactersDir_;
     std::string eventsFile_;
     std::string savesDir_;
+    std::string saveMode_;
+    std::string saveFormat_;
+    std::string saveCompression_;
+    int journalCompactEvery_;
     int defaultInitialAffection_;
+    int candidateCount_;
+    int candidateDeadlineMs_;
+    int rosterMemoryCapKb_;
+    int typingCharsPerSecond_;
+    int typingFrameRate_;
+    int autosaveIntervalSeconds_;
+    bool statusBar_;
 };
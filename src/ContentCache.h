@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "AssetBundle.h"
+#include "FileIO.h"
+
+/**
+ * 파일 하나를 파싱한 결과를 경로별로 보관하는 캐시입니다.
+ *
+ * 수정 시각과 크기가 그대로면 파일을 다시 읽지 않고, 바뀌었더라도 내용 체크섬이 같으면
+ * (저장만 다시 한 경우) 다시 파싱하지 않습니다. 체크섬을 위해 읽은 내용은 그대로 파서에 넘깁니다.
+ * 경로는 Assets와 같은 순서로 찾으므로 번들에 든 에셋이 같은 경로의 개별 파일보다 우선하며,
+ * 번들 안의 에셋은 바뀌지 않으므로 한 번만 파싱합니다.
+ * 결과는 shared_ptr로 돌려주므로 새 결과로 바뀌어도 이전 결과를 쓰던 쪽은 안전하게 계속 쓸 수 있습니다.
+ * 항목은 Erase할 때까지 남으므로, 결과를 쓰는 쪽이 더 이상 필요 없어진 경로를 내려놓아야 합니다.
+ */
+template <typename T>
+class ContentCache {
+public:
+    // 개별 파일이면 `contents`에 캐시가 이미 읽은 파일 내용을, 번들 에셋이면 nullptr을 넘깁니다. (Assets로 읽음)
+    using Parser = std::function<std::shared_ptr<const T>(const std::string& path, const std::string* contents)>;
+
+    // 캐시된 결과를 반환하고, 파일이 바뀌었으면 다시 파싱합니다. 파일이 없거나 첫 파싱에 실패하면 nullptr을 반환합니다.
+    // 바뀐 파일의 파싱에 실패하면(예: 편집 중 저장) 이전 결과를 계속 돌려주고 다음 호출에서 다시 시도합니다.
+    std::shared_ptr<const T> Get(const std::string& path, const Parser& parse) {
+        Stamp stamp;
+        if (!StampOf(path, stamp)) {
+            entries_.erase(path);
+            return nullptr;
+        }
+        auto it = entries_.find(path);
+        if (it != entries_.end() && it->second.stamp == stamp) return it->second.value;
+
+        std::uint32_t crc = 0;
+        std::string bytes;
+        if (!stamp.bundled) {
+            if (!FileIO::ReadAll(path, bytes)) return it != entries_.end() ? it->second.value : nullptr;
+            crc = FileIO::Crc32(bytes);
+            if (it != entries_.end() && it->second.crc == crc) {
+                it->second.stamp = stamp;
+                return it->second.value;
+            }
+        }
+
+        std::shared_ptr<const T> value = parse(path, stamp.bundled ? nullptr : &bytes);
+        if (!value) return it != entries_.end() ? it->second.value : nullptr;
+        entries_[path] = Entry{stamp, crc, value};
+        return value;
+    }
+
+    // 경로의 항목을 내려놓습니다. 다음 Get에서 다시 읽고 파싱합니다.
+    void Erase(const std::string& path) { entries_.erase(path); }
+
+    // 캐시된 항목 수를 반환합니다.
+    std::size_t Size() const { return entries_.size(); }
+
+private:
+    struct Stamp {
+        std::int64_t mtime = 0;
+        std::uintmax_t size = 0;
+        bool bundled = false;
+
+        bool operator==(const Stamp& other) const {
+            return mtime == other.mtime && size == other.size && bundled == other.bundled;
+        }
+    };
+
+    struct Entry {
+        Stamp stamp;
+        std::uint32_t crc = 0;
+        std::shared_ptr<const T> value;
+    };
+
+    // Assets가 읽는 쪽을 봅니다. 번들에 있으면 개별 파일이 있어도 번들 에셋입니다.
+    static bool StampOf(const std::string& path, Stamp& out) {
+        if (Assets::InBundle(path)) {
+            out = Stamp{0, 0, true};
+            return true;
+        }
+        std::error_code ec;
+        if (!std::filesystem::is_regular_file(path, ec)) return false;
+        out.mtime = static_cast<std::int64_t>(std::filesystem::last_write_time(path, ec).time_since_epoch().count());
+        out.size = std::filesystem::file_size(path, ec);
+        out.bundled = false;
+        return !ec;
+    }
+
+    std::unordered_map<std::string, Entry> entries_;
+};
@@ -0,0 +1,166 @@
+#include "ContentWatcher.h"
+
+#include <algorithm>
+#include <iostream>
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace {
+std::string NormalizeDirectory(const std::string& directory) {
+    return std::filesystem::path(directory).lexically_normal().generic_string();
+}
+
+#ifndef __linux__
+// 디렉토리 안 파일의 수정 시각을 모으고, 하위 디렉토리 경로는 `subdirectories`에 채웁니다.
+std::map<std::string, std::filesystem::file_time_type> Snapshot(const std::string& directory,
+                                                                std::set<std::string>& subdirectories) {
+    std::map<std::string, std::filesystem::file_time_type> files;
+    subdirectories.clear();
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, ec)) {
+        if (entry.is_regular_file(ec)) {
+            files[entry.path().generic_string()] = entry.last_write_time(ec);
+        } else if (entry.is_directory(ec)) {
+            subdirectories.insert(entry.path().generic_string());
+        }
+    }
+    return files;
+}
+#endif
+}  // 익명 네임스페이스 종료
+
+void ContentWatcher::WatchCreated(const std::string& directory, std::vector<std::string>& changed) {
+    if (!Watch(directory)) return;
+    changed.push_back(NormalizeDirectory(directory));
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, ec)) {
+        if (entry.is_directory(ec)) {
+            WatchCreated(entry.path().generic_string(), changed);
+        } else if (entry.is_regular_file(ec)) {
+            changed.push_back(entry.path().generic_string());
+        }
+    }
+}
+
+#ifdef __linux__
+
+ContentWatcher::ContentWatcher() : fd_(inotify_init1(IN_NONBLOCK | IN_CLOEXEC)) {
+    if (fd_ < 0) {
+        std::cerr << "[ContentWatcher] inotify를 열 수 없습니다: " << std::strerror(errno) << '\n';
+    }
+}
+
+ContentWatcher::~ContentWatcher() {
+    if (fd_ >= 0) close(fd_);
+}
+
+bool ContentWatcher::Watch(const std::string& directory) {
+    std::string normalized = NormalizeDirectory(directory);
+    std::error_code ec;
+    if (fd_ < 0 || watched_.count(normalized) || !std::filesystem::is_directory(normalized, ec)) return false;
+
+    // 편집기는 임시 파일에 쓴 뒤 이름을 바꾸는 경우가 많아 MOVED_TO도 함께 봅니다.
+    // 새 하위 디렉토리는 CREATE/MOVED_TO(IN_ISDIR)로 알 수 있습니다.
+    int wd = inotify_add_watch(fd_, normalized.c_str(),
+                               IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_CREATE | IN_DELETE);
+    if (wd < 0) {
+        std::cerr << "[ContentWatcher] 디렉토리를 감시할 수 없습니다(" << normalized << "): " << std::strerror(errno) << '\n';
+        return false;
+    }
+    watched_.insert(normalized);
+    directories_[wd] = normalized;
+    return true;
+}
+
+std::vector<std::string> ContentWatcher::Poll() {
+    std::vector<std::string> changed;
+    if (fd_ < 0) return changed;
+
+    alignas(inotify_event) char buffer[4096];
+    std::vector<std::string> created;
+    while (true) {
+        ssize_t length = read(fd_, buffer, sizeof(buffer));
+        if (length <= 0) break;  // EAGAIN: 더 읽을 이벤트 없음
+        for (ssize_t offset = 0; offset < length;) {
+            const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+            auto dir = directories_.find(event->wd);
+            if (dir == directories_.end()) continue;
+            if (event->mask & IN_IGNORED) {
+                // 디렉토리가 지워져 커널이 감시를 없앰. 다시 만들어지면 새로 감시할 수 있도록 목록에서 뺍니다.
+                watched_.erase(dir->second);
+                directories_.erase(dir);
+                continue;
+            }
+            if (event->len == 0) continue;
+            std::string path = dir->second + "/" + event->name;
+            if ((event->mask & IN_ISDIR) && (event->mask & (IN_CREATE | IN_MOVED_TO))) created.push_back(path);
+            changed.push_back(std::move(path));
+        }
+    }
+    for (const auto& directory : created) WatchCreated(directory, changed);
+    std::sort(changed.begin(), changed.end());
+    changed.erase(std::unique(changed.begin(), changed.end()), changed.end());
+    return changed;
+}
+
+#else
+
+ContentWatcher::ContentWatcher() = default;
+
+ContentWatcher::~ContentWatcher() = default;
+
+bool ContentWatcher::Watch(const std::string& directory) {
+    std::string normalized = NormalizeDirectory(directory);
+    std::error_code ec;
+    if (watched_.count(normalized) || !std::filesystem::is_directory(normalized, ec)) return false;
+    watched_.insert(normalized);
+    snapshots_[normalized] = Snapshot(normalized, subdirectories_[normalized]);
+    return true;
+}
+
+std::vector<std::string> ContentWatcher::Poll() {
+    std::vector<std::string> changed;
+    std::vector<std::string> created;
+    for (auto it = snapshots_.begin(); it != snapshots_.end();) {
+        const std::string& directory = it->first;
+        auto& before = it->second;
+        std::error_code ec;
+        if (!std::filesystem::is_directory(directory, ec)) {
+            // 디렉토리가 지워짐. 안의 파일도 지워진 것으로 알리고, 다시 만들어지면 새로 감시할 수 있도록 목록에서 뺍니다.
+            for (const auto& [file, time] : before) changed.push_back(file);
+            watched_.erase(directory);
+            subdirectories_.erase(directory);
+            it = snapshots_.erase(it);
+            continue;
+        }
+        // 하위 디렉토리 목록을 지난번과 비교해 새로 생긴 것만 감시합니다.
+        std::set<std::string>& known = subdirectories_[directory];
+        std::set<std::string> subdirectories;
+        auto after = Snapshot(directory, subdirectories);
+        for (const auto& [file, time] : after) {
+            auto found = before.find(file);
+            if (found == before.end() || found->second != time) changed.push_back(file);
+        }
+        for (const auto& [file, time] : before) {
+            if (!after.count(file)) changed.push_back(file);
+        }
+        for (const auto& subdirectory : subdirectories) {
+            if (!known.count(subdirectory)) created.push_back(subdirectory);
+        }
+        known = std::move(subdirectories);
+        before = std::move(after);
+        ++it;
+    }
+    for (const auto& directory : created) WatchCreated(directory, changed);
+    std::sort(changed.begin(), changed.end());
+    changed.erase(std::unique(changed.begin(), changed.end()), changed.end());
+    return changed;
+}
+
+#endif
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <filesystem>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * 콘텐츠 디렉토리의 파일 변경을 감지합니다.
+ *
+ * Linux에서는 inotify로 커널이 알려준 변경만 읽고(논블로킹), 그 밖의 플랫폼에서는
+ * Poll할 때 감시 중인 디렉토리의 수정 시각을 비교합니다. 이미 있는 하위 디렉토리는 따로 등록해야 하지만,
+ * 감시 중인 디렉토리에 새로 생긴 하위 디렉토리는 자동으로 감시하고 그 안의 파일도 변경으로 알립니다.
+ */
+class ContentWatcher {
+public:
+    ContentWatcher();
+    ~ContentWatcher();
+
+    ContentWatcher(const ContentWatcher&) = delete;
+    ContentWatcher& operator=(const ContentWatcher&) = delete;
+
+    // 디렉토리를 감시 목록에 추가합니다. 이미 있거나 디렉토리가 아니면 false를 반환합니다.
+    bool Watch(const std::string& directory);
+
+    // 마지막 호출 이후 생성·수정·삭제된 파일 경로를 중복 없이 반환합니다. 기다리지 않습니다.
+    std::vector<std::string> Poll();
+
+private:
+    // 새로 생긴 디렉토리와 그 하위 디렉토리를 감시하고, 그 경로와 안에 이미 있던 파일을 `changed`에 더합니다.
+    // (감시를 시작하기 전에 만들어진 파일은 알림이 오지 않으므로 직접 훑습니다)
+    void WatchCreated(const std::string& directory, std::vector<std::string>& changed);
+
+    std::unordered_set<std::string> watched_;
+#ifdef __linux__
+    int fd_;
+    std::unordered_map<int, std::string> directories_;  // 감시 번호 → 디렉토리
+#else
+    std::map<std::string, std::map<std::string, std::filesystem::file_time_type>> snapshots_;
+    std::map<std::string, std::set<std::string>> subdirectories_;  // 지난 Poll 때 있던 하위 디렉토리
+#endif
+};
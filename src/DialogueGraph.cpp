@@ -0,0 +1,190 @@
+#include "DialogueGraph.h"
+
+namespace {
+// 순환 검사용 DFS 상태
+enum class Visit : std::uint8_t { New, Active, Done };
+}  // 익명 네임스페이스 종료
+
+DialogueGraph::DialogueGraph() {
+    // 0번 문자열은 빈 문자열로 예약합니다. (화자 없음 등)
+    spans_.emplace_back(0, 0);
+    internIndex_.emplace(std::string(), 0);
+}
+
+std::uint32_t DialogueGraph::AddScript(const nlohmann::json& script, std::string& error) {
+    if (!script.is_array() || script.empty()) {
+        error = "스크립트는 비어 있지 않은 배열이어야 합니다";
+        return kEnd;
+    }
+
+    // 1단계: 라벨을 모으고 노드 형식을 확인합니다.
+    const std::size_t count = script.size();
+    std::unordered_map<std::string, std::uint32_t> labels;
+    for (std::size_t i = 0; i < count; ++i) {
+        const nlohmann::json& node = script[i];
+        if (!node.is_object()) {
+            error = "노드 " + std::to_string(i) + "가 객체가 아닙니다";
+            return kEnd;
+        }
+        int kinds = node.contains("say") + node.contains("generate") + node.contains("choices");
+        if (kinds != 1) {
+            error = "노드 " + std::to_string(i) + "에는 say, generate, choices 중 하나만 있어야 합니다";
+            return kEnd;
+        }
+        if (node.contains("choices") && (!node["choices"].is_array() || node["choices"].empty())) {
+            error = "노드 " + std::to_string(i) + "의 choices가 비어 있습니다";
+            return kEnd;
+        }
+        if (node.contains("label") && !labels.emplace(node.value("label", ""), static_cast<std::uint32_t>(i)).second) {
+            error = "라벨이 중복되었습니다: " + node.value("label", "");
+            return kEnd;
+        }
+    }
+
+    // 2단계: 간선을 스크립트 안의 위치로 풉니다.
+    auto resolve = [&](const nlohmann::json& from, std::size_t fallthrough, std::uint32_t& out) {
+        if (from.value("end", false)) {
+            out = kEnd;
+            return true;
+        }
+        if (!from.contains("goto")) {
+            out = fallthrough < count ? static_cast<std::uint32_t>(fallthrough) : kEnd;
+            return true;
+        }
+        auto it = labels.find(from.value("goto", ""));
+        if (it == labels.end()) {
+            error = "없는 라벨로 이동합니다: " + from.value("goto", "");
+            return false;
+        }
+        out = it->second;
+        return true;
+    };
+
+    // 문자열은 검사를 통과할 때까지 풀에 넣지 않고 지역 번호로만 가리킵니다.
+    std::vector<std::string> texts;
+    auto local = [&texts](std::string text) {
+        texts.push_back(std::move(text));
+        return static_cast<std::uint32_t>(texts.size() - 1);
+    };
+
+    std::vector<Node> nodes(count);
+    std::vector<Choice> choices;
+    try {
+        for (std::size_t i = 0; i < count; ++i) {
+            const nlohmann::json& source = script[i];
+            Node& node = nodes[i];
+            node.affection = source.value("affection", 0);
+            if (!resolve(source, i + 1, node.next)) return kEnd;
+            if (source.contains("choices")) {
+                node.kind = NodeKind::Choice;
+                node.next = kEnd;  // 선택지 노드는 선택한 간선으로만 이동합니다.
+                node.firstChoice = static_cast<std::uint32_t>(choices.size());
+                node.choiceCount = static_cast<std::uint32_t>(source["choices"].size());
+                for (const auto& option : source["choices"]) {
+                    Choice choice;
+                    choice.text = local(option.value("text", ""));
+                    choice.affection = option.value("affection", 0);
+                    if (!resolve(option, i + 1, choice.next)) return kEnd;
+                    choices.push_back(choice);
+                }
+            } else {
+                node.kind = source.contains("say") ? NodeKind::Line : NodeKind::Generate;
+                node.text = local(source.value(source.contains("say") ? "say" : "generate", ""));
+            }
+            node.speaker = local(source.value("speaker", ""));
+        }
+    } catch (const nlohmann::json::exception& e) {
+        error = std::string("노드 값의 형식이 잘못되었습니다: ") + e.what();
+        return kEnd;
+    }
+
+    // 3단계: 시작 노드에서 DFS로 순환과 도달할 수 없는 노드를 찾습니다.
+    std::vector<Visit> state(count, Visit::New);
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> stack;  // (노드, 다음에 볼 간선 번호)
+    auto edge = [&](std::uint32_t n, std::uint32_t k) -> std::uint32_t {
+        const Node& node = nodes[n];
+        if (node.kind == NodeKind::Choice) {
+            return k < node.choiceCount ? choices[node.firstChoice + k].next : kEnd - 1;
+        }
+        return k == 0 ? node.next : kEnd - 1;
+    };
+    stack.emplace_back(0, 0);
+    state[0] = Visit::Active;
+    while (!stack.empty()) {
+        auto& [n, k] = stack.back();
+        std::uint32_t target = edge(n, k++);
+        if (target == kEnd - 1) {
+            state[n] = Visit::Done;
+            stack.pop_back();
+            continue;
+        }
+        if (target == kEnd) continue;
+        if (state[target] == Visit::Active) {
+            error = "순환이 있습니다: 노드 " + std::to_string(target);
+            return kEnd;
+        }
+        if (state[target] == Visit::New) {
+            state[target] = Visit::Active;
+            stack.emplace_back(target, 0);
+        }
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        if (state[i] == Visit::New) {
+            error = "도달할 수 없는 노드가 있습니다: 노드 " + std::to_string(i);
+            return kEnd;
+        }
+    }
+
+    // 검사를 통과한 뒤에만 그래프에 덧붙이고 지역 위치와 문자열 번호를 전역 값으로 옮깁니다.
+    std::vector<std::uint32_t> ids;
+    ids.reserve(texts.size());
+    for (const std::string& text : texts) ids.push_back(Intern(text));
+
+    auto base = static_cast<std::uint32_t>(nodes_.size());
+    auto choiceBase = static_cast<std::uint32_t>(choices_.size());
+    for (Node& node : nodes) {
+        if (node.next != kEnd) node.next += base;
+        if (node.kind == NodeKind::Choice) node.firstChoice += choiceBase;
+        else node.text = ids[node.text];
+        node.speaker = ids[node.speaker];
+        nodes_.push_back(node);
+    }
+    for (Choice& choice : choices) {
+        if (choice.next != kEnd) choice.next += base;
+        choice.text = ids[choice.text];
+        choices_.push_back(choice);
+    }
+    return base;
+}
+
+std::uint32_t DialogueGraph::AddLines(const std::vector<std::string>& lines) {
+    if (lines.empty()) return kEnd;
+    auto base = static_cast<std::uint32_t>(nodes_.size());
+    for (std::size_t i = 0; i < lines.size(); ++i) {
+        Node node;
+        node.text = Intern(lines[i]);
+        node.next = i + 1 < lines.size() ? base + static_cast<std::uint32_t>(i + 1) : kEnd;
+        nodes_.push_back(node);
+    }
+    return base;
+}
+
+std::string_view DialogueGraph::Text(std::uint32_t id) const {
+    const auto& [offset, length] = spans_[id];
+    return std::string_view(pool_).substr(offset, length);
+}
+
+std::size_t DialogueGraph::MemoryBytes() const {
+    return nodes_.capacity() * sizeof(Node) + choices_.capacity() * sizeof(Choice) + pool_.capacity() +
+           spans_.capacity() * sizeof(spans_[0]) + internIndex_.size() * (sizeof(std::string) + 2 * sizeof(void*));
+}
+
+std::uint32_t DialogueGraph::Intern(const std::string& text) {
+    auto it = internIndex_.find(text);
+    if (it != internIndex_.end()) return it->second;
+    auto id = static_cast<std::uint32_t>(spans_.size());
+    spans_.emplace_back(static_cast<std::uint32_t>(pool_.size()), static_cast<std::uint32_t>(text.size()));
+    pool_ += text;
+    internIndex_.emplace(text, id);
+    return id;
+}
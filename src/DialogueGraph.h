@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+/**
+ * 이벤트 스크립트를 컴파일한 대화 그래프입니다. 이벤트 묶음 전체가 하나의 그래프를 공유합니다.
+ *
+ * 스크립트(JSON 배열)의 각 노드는 대사(`say`), LLM이 생성할 대사(`generate`), 선택지(`choices`) 중 하나이며
+ * `label`, `speaker`, `affection`(호감도 변화), `goto`(다음 노드 라벨), `end`(여기서 종료)를 덧붙일 수 있습니다.
+ * `goto`가 없으면 다음 노드로 이어집니다.
+ *
+ * 컴파일하면 노드와 선택지는 연속된 배열에, 문자열은 하나의 풀에 모이고, 간선은 배열 위치(정수)가 됩니다.
+ * 컴파일할 때 없는 라벨, 도달할 수 없는 노드, 순환을 검사하므로 재생은 항상 끝납니다.
+ */
+class DialogueGraph {
+public:
+    static constexpr std::uint32_t kEnd = 0xFFFFFFFFu;
+
+    enum class NodeKind : std::uint8_t {
+        Line,      // 정해진 대사
+        Generate,  // `text`를 연출 지시로 LLM이 만드는 대사
+        Choice     // 플레이어 선택지
+    };
+
+    struct Node {
+        NodeKind kind = NodeKind::Line;
+        std::uint32_t text = 0;      // 문자열 풀 번호
+        std::uint32_t speaker = 0;   // 문자열 풀 번호 (0이면 해설)
+        std::int32_t affection = 0;  // 이 노드에 들어올 때의 호감도 변화
+        std::uint32_t next = kEnd;
+        std::uint32_t firstChoice = 0;
+        std::uint32_t choiceCount = 0;
+    };
+
+    struct Choice {
+        std::uint32_t text = 0;
+        std::uint32_t next = kEnd;
+        std::int32_t affection = 0;
+    };
+
+    DialogueGraph();
+
+    // 스크립트 하나를 컴파일해 그래프에 덧붙이고 시작 노드를 반환합니다.
+    // 잘못된 스크립트면 노드를 덧붙이지 않고 kEnd를 반환하며 error에 이유를 씁니다.
+    std::uint32_t AddScript(const nlohmann::json& script, std::string& error);
+
+    // 선택지 없이 차례로 이어지는 대사를 덧붙이고 시작 노드를 반환합니다. (대사가 없으면 kEnd)
+    std::uint32_t AddLines(const std::vector<std::string>& lines);
+
+    const Node& At(std::uint32_t node) const { return nodes_[node]; }
+    const Choice& ChoiceAt(std::uint32_t choice) const { return choices_[choice]; }
+    std::string_view Text(std::uint32_t id) const;
+
+    // 대략적인 메모리 사용량(바이트)을 반환합니다.
+    std::size_t MemoryBytes() const;
+
+private:
+    std::uint32_t Intern(const std::string& text);
+
+    std::vector<Node> nodes_;
+    std::vector<Choice> choices_;
+    std::string pool_;
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> spans_;  // 문자열 번호 → (풀 오프셋, 길이)
+    std::unordered_map<std::string, std::uint32_t> internIndex_;
+};
@@ -0,0 +1,149 @@
+#include "DialogueLog.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <vector>
+
+#include "DialogueManager.h"
+
+namespace {
+// 레코드 헤더: 본문 길이(4) + 역할(1) + 호감도 변화(1) + 화자 길이(2) + 토큰 수(4) + 시각(8)
+constexpr std::size_t kHeaderSize = 20;
+
+template <typename T>
+void Put(char*& out, T value) {
+    std::memcpy(out, &value, sizeof(T));
+    out += sizeof(T);
+}
+
+template <typename T>
+T Take(const char*& in) {
+    T value;
+    std::memcpy(&value, in, sizeof(T));
+    in += sizeof(T);
+    return value;
+}
+}  // 익명 네임스페이스 종료
+
+DialogueLog::DialogueLog(std::string basePath)
+    : logPath_(basePath + ".log"),
+      indexPath_(basePath + ".idx"),
+      logSize_(0),
+      count_(0) {}
+
+DialogueLog::~DialogueLog() {
+    Reset();
+}
+
+bool DialogueLog::EnsureOpen() {
+    if (log_.is_open() && index_.is_open()) return true;
+
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    fs::create_directories(fs::path(logPath_).parent_path(), ec);
+
+    log_.open(logPath_, std::ios::binary | std::ios::trunc);
+    index_.open(indexPath_, std::ios::binary | std::ios::trunc);
+    if (!log_.is_open() || !index_.is_open()) {
+        std::cerr << "[DialogueLog] 로그 파일을 열 수 없습니다: " << logPath_ << '\n';
+        log_.close();
+        index_.close();
+        return false;
+    }
+    logSize_ = 0;
+    count_ = 0;
+    return true;
+}
+
+bool DialogueLog::Append(TurnRole role, std::string_view speaker, std::string_view text,
+                         int affectionDelta, std::uint32_t tokenCount, std::int64_t timestamp) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!EnsureOpen()) return false;
+
+    auto speakerLength = static_cast<std::uint16_t>(std::min<std::size_t>(speaker.size(), UINT16_MAX));
+    auto payloadLength = static_cast<std::uint32_t>(speakerLength + text.size());
+
+    char header[kHeaderSize];
+    char* out = header;
+    Put(out, payloadLength);
+    Put(out, static_cast<std::uint8_t>(role));
+    Put(out, static_cast<std::int8_t>(affectionDelta));
+    Put(out, speakerLength);
+    Put(out, tokenCount);
+    Put(out, timestamp);
+
+    log_.write(header, kHeaderSize);
+    log_.write(speaker.data(), speakerLength);
+    log_.write(text.data(), static_cast<std::streamsize>(text.size()));
+    index_.write(reinterpret_cast<const char*>(&logSize_), sizeof(logSize_));
+    if (!log_ || !index_) {
+        std::cerr << "[DialogueLog] 로그 기록 실패: " << logPath_ << '\n';
+        return false;
+    }
+
+    logSize_ += kHeaderSize + payloadLength;
+    ++count_;
+    return true;
+}
+
+std::size_t DialogueLog::Size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return count_;
+}
+
+bool DialogueLog::Read(std::size_t begin, std::size_t end,
+                       const std::function<bool(const LoggedTurn&)>& fn) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    end = std::min(end, count_);
+    if (begin >= end) return true;
+
+    // 버퍼에 남은 기록을 먼저 내보내야 읽기 스트림에서 보입니다.
+    log_.flush();
+    index_.flush();
+
+    std::ifstream index(indexPath_, std::ios::binary);
+    std::ifstream log(logPath_, std::ios::binary);
+    if (!index.is_open() || !log.is_open()) return false;
+
+    std::uint64_t offset = 0;
+    index.seekg(static_cast<std::streamoff>(begin * sizeof(offset)));
+    if (!index.read(reinterpret_cast<char*>(&offset), sizeof(offset))) return false;
+    log.seekg(static_cast<std::streamoff>(offset));
+
+    // 레코드는 연속으로 붙어 있으므로 시작 위치만 찾으면 이후로는 순차 읽기입니다.
+    LoggedTurn turn;
+    std::vector<char> payload;
+    for (std::size_t i = begin; i < end; ++i) {
+        char header[kHeaderSize];
+        if (!log.read(header, kHeaderSize)) return false;
+
+        const char* in = header;
+        auto payloadLength = Take<std::uint32_t>(in);
+        turn.role = static_cast<TurnRole>(Take<std::uint8_t>(in));
+        turn.affectionDelta = Take<std::int8_t>(in);
+        auto speakerLength = Take<std::uint16_t>(in);
+        turn.tokenCount = Take<std::uint32_t>(in);
+        turn.timestamp = Take<std::int64_t>(in);
+
+        payload.resize(payloadLength);
+        if (payloadLength > 0 && !log.read(payload.data(), payloadLength)) return false;
+        turn.speaker.assign(payload.data(), std::min<std::size_t>(speakerLength, payloadLength));
+        turn.text.assign(payload.data() + turn.speaker.size(), payloadLength - turn.speaker.size());
+
+        if (!fn(turn)) break;
+    }
+    return true;
+}
+
+void DialogueLog::Reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    log_.close();
+    index_.close();
+    std::error_code ec;
+    std::filesystem::remove(logPath_, ec);
+    std::filesystem::remove(indexPath_, ec);
+    logSize_ = 0;
+    count_ = 0;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+enum class TurnRole : std::uint8_t;
+
+/**
+ * 디스크로 내보낸(spill) 대화 턴 한 개를 읽어올 때 사용하는 레코드입니다.
+ */
+struct LoggedTurn {
+    TurnRole role;
+    int affectionDelta = 0;
+    std::uint32_t tokenCount = 0;
+    std::int64_t timestamp = 0;
+    std::string speaker;
+    std::string text;
+};
+
+/**
+ * 메모리 창에서 밀려난 오래된 턴을 보관하는 추가 전용(append-only) 로그입니다.
+ * `<base>.log`에 가변 길이 레코드를, `<base>.idx`에 레코드별 8바이트 오프셋을 기록하므로
+ * 임의의 턴을 메모리에 색인을 올리지 않고도 한 번의 탐색으로 읽을 수 있습니다.
+ * 저장 스레드가 스냅샷을 읽는 동안 게임 스레드가 추가할 수 있으므로 내부적으로 잠급니다.
+ */
+class DialogueLog {
+public:
+    explicit DialogueLog(std::string basePath);
+    ~DialogueLog();
+
+    DialogueLog(const DialogueLog&) = delete;
+    DialogueLog& operator=(const DialogueLog&) = delete;
+
+    // 로그 끝에 턴 하나를 추가합니다.
+    bool Append(TurnRole role, std::string_view speaker, std::string_view text,
+                int affectionDelta, std::uint32_t tokenCount, std::int64_t timestamp);
+
+    // 기록된 레코드 수를 반환합니다.
+    std::size_t Size() const;
+
+    // [begin, end) 구간의 레코드를 순서대로 읽어 `fn`에 전달합니다. `fn`이 false를 반환하면 중단합니다.
+    bool Read(std::size_t begin, std::size_t end, const std::function<bool(const LoggedTurn&)>& fn) const;
+
+    // 로그와 색인 파일을 비우고 삭제합니다.
+    void Reset();
+
+private:
+    bool EnsureOpen();
+
+    mutable std::mutex mutex_;
+    std::string logPath_;
+    std::string indexPath_;
+    mutable std::ofstream log_;
+    mutable std::ofstream index_;
+    std::uint64_t logSize_;
+    std::size_t count_;
+};
@@ -2,6 +2,10 @@
 
 #include <algorithm>
 #include <cctype>
+#include <chrono>
+#include <atomic>
+#include <climits>
+#include <iostream>
 #include <sstream>
 #include <utility>
 #include <vector>
@@ -9,9 +13,13 @@
 #include "Config.h"
 #include "LLMClient.h"
 #include "Character.h"
-#include <fstream>
+#include "DialogueLog.h"
+#include <filesystem>
 
 namespace {
+// 스필 로그의 세대 번호. 스냅샷이 따로 만드는 로그와도 이름이 겹치지 않도록 프로세스 전체에서 셉니다.
+std::atomic<std::size_t> nextSpillGeneration{0};
+
 std::string ToLower(const std::string& text) {
     std::string lowered = text;
     std::transform(lowered.begin(), lowered.end(), lowered.begin(),
@@ -28,24 +36,326 @@ void ReplaceAll(std::string& str, const std::string& from, const std::string& to
          start_pos += to.length();
      }
 }
+
+// 토큰 수를 대략 추정합니다. (ASCII는 4글자당 1토큰, 그 외 문자는 글자당 1토큰)
+std::uint32_t EstimateTokens(std::string_view text) {
+    std::uint32_t ascii = 0;
+    std::uint32_t others = 0;
+    for (unsigned char ch : text) {
+        if (ch < 0x80) ++ascii;
+        else if ((ch & 0xC0) != 0x80) ++others;  // UTF-8 선두 바이트만 셈
+    }
+    return (ascii + 3) / 4 + others;
+}
+
+// 캐릭터를 깨뜨리는 응답에서 자주 보이는 패턴 (소문자 기준)
+const std::vector<std::string> kBannedPatterns = {
+    "as an ai", "language model", "assistant", "ai 언어", "언어 모델", "인공지능",
+    "##instruction##", "<<<<user_input>>>>", "system reminder", "```", "error:"
+};
+
+// "3문장 이내" 같은 특성에서 문장 수 제한을 읽어옵니다. 없으면 0을 반환합니다.
+int ParseSentenceLimit(const std::vector<std::string>& traits) {
+    const std::string marker = "문장 이내";
+    for (const auto& trait : traits) {
+        size_t pos = trait.find(marker);
+        if (pos == std::string::npos) continue;
+        size_t end = pos;
+        while (end > 0 && trait[end - 1] == ' ') --end;
+        size_t begin = end;
+        while (begin > 0 && std::isdigit(static_cast<unsigned char>(trait[begin - 1]))) --begin;
+        if (begin < end) return std::stoi(trait.substr(begin, end - begin));
+    }
+    return 0;
+}
+
+// 종결 부호(. ! ? …) 단위로 문장 수를 셉니다. *행동 묘사*는 문장으로 치지 않습니다.
+int CountSentences(const std::string& text) {
+    int count = 0;
+    bool inAction = false;
+    bool hasContent = false;
+    for (size_t i = 0; i < text.size(); ++i) {
+        char ch = text[i];
+        if (ch == '*') {
+            inAction = !inAction;
+            continue;
+        }
+        if (inAction) continue;
+        bool terminator = ch == '.' || ch == '!' || ch == '?' ||
+                          text.compare(i, 3, "…") == 0;
+        if (terminator) {
+            if (hasContent) ++count;
+            hasContent = false;
+        } else if (!std::isspace(static_cast<unsigned char>(ch))) {
+            hasContent = true;
+        }
+    }
+    if (hasContent) ++count;
+    return count;
+}
+
+// 특성 문장에서 비교에 쓸 만한 단어(2글자 이상)를 뽑아냅니다.
+std::vector<std::string> ExtractTraitKeywords(const std::vector<std::string>& traits) {
+    std::vector<std::string> keywords;
+    for (const auto& trait : traits) {
+        std::istringstream words(trait);
+        std::string word;
+        while (words >> word) {
+            word.erase(std::remove_if(word.begin(), word.end(), [](unsigned char ch) {
+                           return ch < 0x80 && !std::isalnum(ch);
+                       }),
+                       word.end());
+            // 한글 2글자 = 6바이트
+            if (word.size() >= 6) keywords.push_back(ToLower(word));
+        }
+    }
+    return keywords;
+}
 }  // 익명 네임스페이스 종료
 
-void DialogueContext::AddTurn(const std::string& speaker, const std::string& text) {
-    history_.push_back({speaker, text});
+DialogueContext::DialogueContext()
+    : storage_(std::make_shared<Storage>()),
+      capacity_(0) {
+    storage_->ring.reserve(256);
+    storage_->arena.reserve(64 * 1024);
 }
 
+DialogueContext::DialogueContext(const DialogueContext& other) {
+    *this = other;
+}
+
+DialogueContext& DialogueContext::operator=(const DialogueContext& other) {
+    if (this == &other) return *this;
+    // 로더를 복사하면 두 쪽에서 같은 복원을 따로 돌리게 되므로(저장 스레드 포함) 원본에서 먼저 끝냅니다.
+    other.Materialize();
+    storage_ = other.storage_;
+    capacity_ = other.capacity_;
+    spillPath_ = other.spillPath_;
+    spill_ = other.spill_;
+    ownsSpill_ = false;
+    deferred_.clear();
+    deferredTurns_ = 0;
+    return *this;
+}
 
+DialogueContext::~DialogueContext() = default;
+
+void DialogueContext::Configure(std::size_t hotCapacity, std::string spillPath) {
+    capacity_ = hotCapacity;
+    spillPath_ = std::move(spillPath);
+    Clear();
+}
+
+DialogueContext::Storage& DialogueContext::Mutable() {
+    if (storage_.use_count() > 1) {
+        storage_ = std::make_shared<Storage>(*storage_);
+    }
+    return *storage_;
+}
+
+void DialogueContext::AddTurn(TurnRole role, const std::string& speaker, std::string_view text,
+                              int affectionDelta, std::int64_t timestamp) {
+    Materialize();
+    if (timestamp == 0) {
+        timestamp = std::chrono::duration_cast<std::chrono::seconds>(
+                        std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    Storage& storage = Mutable();
+    // 앞서 내보내지 못해 창이 늘어났으면 기록이 다시 될 때 창 크기로 줄어들 때까지 내보냅니다.
+    while (capacity_ > 0 && storage.count >= capacity_ && SpillOldest(storage)) {
+    }
+    if (capacity_ > 0 && storage.count == capacity_) {
+        std::cerr << "[DialogueContext] 오래된 턴을 디스크로 내보내지 못해 메모리에 유지합니다.\n";
+    }
+
+    DialogueTurn turn{};
+    turn.timestamp = timestamp;
+    turn.textOffset = static_cast<std::uint32_t>(storage.arena.size());
+    turn.textLength = static_cast<std::uint32_t>(text.size());
+    turn.tokenCount = EstimateTokens(text);
+    turn.speakerId = InternSpeaker(storage, speaker);
+    turn.affectionDelta = static_cast<std::int8_t>(std::clamp(affectionDelta, -128, 127));
+    turn.role = role;
+
+    storage.arena.append(text.data(), text.size());
+
+    if (storage.count == storage.ring.size()) {
+        // 링이 가득 찼으면(처음 채우는 중이거나 내보내지 못함) 순서대로 펼친 뒤 뒤에 덧붙여 늘립니다.
+        std::rotate(storage.ring.begin(), storage.ring.begin() + static_cast<std::ptrdiff_t>(storage.head),
+                    storage.ring.end());
+        storage.head = 0;
+        storage.ring.push_back(turn);
+    } else {
+        storage.ring[(storage.head + storage.count) % storage.ring.size()] = turn;
+    }
+    ++storage.count;
+}
+
+bool DialogueContext::SpillOldest(Storage& storage) {
+    const DialogueTurn& oldest = storage.ring[storage.head];
+    if (!ownsSpill_ && !ForkSpill(storage)) return false;
+    if (!spill_ && !spillPath_.empty()) {
+        spill_ = std::make_shared<DialogueLog>(spillPath_ + "_" + std::to_string(nextSpillGeneration++));
+    }
+    // 로그의 레코드 순서가 곧 턴 인덱스이므로, 기록하지 못한 턴을 내보낸 것으로 세면 이후 턴이 모두 어긋납니다.
+    if (!spill_ || !spill_->Append(oldest.role, storage.speakers[oldest.speakerId],
+                                   std::string_view(storage.arena).substr(oldest.textOffset, oldest.textLength),
+                                   oldest.affectionDelta, oldest.tokenCount, oldest.timestamp)) {
+        return false;
+    }
+    storage.head = (storage.head + 1) % storage.ring.size();
+    --storage.count;
+    ++storage.spilled;
+
+    // 아레나 앞부분의 죽은 영역이 절반을 넘으면 살아있는 본문만 앞으로 당겨 메모리를 일정하게 유지합니다.
+    std::size_t liveBegin = storage.count > 0 ? storage.ring[storage.head].textOffset : storage.arena.size();
+    if (liveBegin >= 4096 && liveBegin * 2 >= storage.arena.size()) {
+        storage.arena.erase(0, liveBegin);
+        for (auto& turn : storage.ring) {
+            turn.textOffset = turn.textOffset >= liveBegin ? turn.textOffset - static_cast<std::uint32_t>(liveBegin) : 0;
+        }
+    }
+    return true;
+}
+
+bool DialogueContext::ForkSpill(const Storage& storage) {
+    if (spillPath_.empty()) return false;
+    auto own = std::make_shared<DialogueLog>(spillPath_ + "_" + std::to_string(nextSpillGeneration++));
+    bool ok = true;
+    if (spill_ && storage.spilled > 0) {
+        ok = spill_->Read(0, storage.spilled, [&](const LoggedTurn& turn) {
+            ok = own->Append(turn.role, turn.speaker, turn.text, turn.affectionDelta, turn.tokenCount, turn.timestamp);
+            return ok;
+        }) && ok;
+        ok = ok && own->Size() == storage.spilled;
+    }
+    if (!ok) {
+        std::cerr << "[DialogueContext] 스냅샷의 스필 로그를 분리하지 못했습니다.\n";
+        return false;
+    }
+    spill_ = std::move(own);
+    ownsSpill_ = true;
+    return true;
+}
 
 void DialogueContext::Clear() {
-    history_.clear();
+    // 스냅샷이 아직 이전 저장소와 로그를 읽고 있을 수 있으므로 지우지 않고 새로 만듭니다.
+    storage_ = std::make_shared<Storage>();
+    storage_->ring.reserve(capacity_ > 0 ? capacity_ : 256);
+    spill_.reset();
+    ownsSpill_ = true;
+    deferred_.clear();
+    deferredTurns_ = 0;
+}
+
+void DialogueContext::Defer(std::function<void(DialogueContext&)> loader, std::size_t turns) {
+    deferred_.push_back(std::move(loader));
+    deferredTurns_ += turns;
+}
+
+void DialogueContext::Materialize() const {
+    if (deferred_.empty()) return;
+    // 지연 복원은 논리적으로 상수인 조회 안에서 일어나므로 const를 벗겨 실행합니다.
+    auto loaders = std::move(deferred_);
+    deferred_.clear();
+    deferredTurns_ = 0;
+    auto& self = const_cast<DialogueContext&>(*this);
+    for (auto& loader : loaders) {
+        loader(self);
+    }
+}
+
+std::size_t DialogueContext::Size() const {
+    // 미뤄 둔 턴은 개수만 더하고 복원하지 않습니다.
+    return storage_->spilled + storage_->count + deferredTurns_;
+}
+
+std::size_t DialogueContext::HotBegin() const {
+    Materialize();
+    return storage_->spilled;
+}
+
+const DialogueTurn& DialogueContext::At(std::size_t index) const {
+    const Storage& storage = *storage_;
+    return storage.ring[(storage.head + index - storage.spilled) % storage.ring.size()];
+}
+
+std::string_view DialogueContext::Text(const DialogueTurn& turn) const {
+    return std::string_view(storage_->arena).substr(turn.textOffset, turn.textLength);
+}
+
+const std::string& DialogueContext::Speaker(const DialogueTurn& turn) const {
+    return storage_->speakers[turn.speakerId];
+}
+
+void DialogueContext::ForEachTurn(std::size_t begin, std::size_t end,
+                                  const std::function<bool(const TurnView&)>& fn) const {
+    Materialize();
+    end = std::min(end, Size());
+    std::size_t spilled = storage_->spilled;
+    bool keepGoing = true;
+
+    if (begin < spilled && spill_) {
+        spill_->Read(begin, std::min(end, spilled), [&](const LoggedTurn& logged) {
+            keepGoing = fn({logged.role, logged.speaker, logged.text,
+                            logged.timestamp, logged.tokenCount, logged.affectionDelta});
+            return keepGoing;
+        });
+    }
+
+    for (std::size_t i = std::max(begin, spilled); keepGoing && i < end; ++i) {
+        const DialogueTurn& turn = At(i);
+        keepGoing = fn({turn.role, Speaker(turn), Text(turn),
+                        turn.timestamp, turn.tokenCount, turn.affectionDelta});
+    }
 }
 
-const std::vector<DialogueTurn>& DialogueContext::History() const {
-    return history_;
+std::vector<std::size_t> DialogueContext::Search(std::string_view needle, std::size_t maxResults) const {
+    std::vector<std::size_t> hits;
+    if (needle.empty() || maxResults == 0) return hits;
+    Materialize();
+
+    // 최근 턴부터 페이지 단위로 거슬러 올라가며, 결과가 차면 더 오래된 페이지는 읽지 않습니다.
+    constexpr std::size_t kPageSize = 64;
+    std::size_t pageEnd = Size();
+    while (pageEnd > 0 && hits.size() < maxResults) {
+        std::size_t pageBegin = pageEnd > kPageSize ? pageEnd - kPageSize : 0;
+        std::vector<std::size_t> pageHits;
+        std::size_t index = pageBegin;
+        ForEachTurn(pageBegin, pageEnd, [&](const TurnView& turn) {
+            if (turn.text.find(needle) != std::string_view::npos) pageHits.push_back(index);
+            ++index;
+            return true;
+        });
+        for (auto it = pageHits.rbegin(); it != pageHits.rend() && hits.size() < maxResults; ++it) {
+            hits.push_back(*it);
+        }
+        pageEnd = pageBegin;
+    }
+    return hits;
+}
+
+std::uint16_t DialogueContext::InternSpeaker(Storage& storage, const std::string& name) {
+    auto it = storage.speakerIds.find(name);
+    if (it != storage.speakerIds.end()) {
+        return it->second;
+    }
+    auto id = static_cast<std::uint16_t>(storage.speakers.size());
+    storage.speakers.push_back(name);
+    storage.speakerIds.emplace(name, id);
+    return id;
 }
 
 DialogueManager::DialogueManager(const Config& config)
-    : config_(config) {}
+    : config_(config) {
+    // 세션마다 고유한 스필 로그 경로를 사용합니다. (세이브 디렉토리 아래 임시 파일)
+    auto sessionId = std::chrono::duration_cast<std::chrono::milliseconds>(
+                         std::chrono::system_clock::now().time_since_epoch()).count();
+    std::filesystem::path spillPath = std::filesystem::path(config_.GetSavesDir()) / "sessions" /
+                                      ("session_" + std::to_string(sessionId));
+    context_.Configure(static_cast<std::size_t>(std::max(0, config_.GetHistoryWindow())), spillPath.string());
+}
 
 DialogueContext& DialogueManager::GetContext() {
     return context_;
@@ -73,7 +383,8 @@ int DialogueManager::ScoreAffectionDelta(const std::string& userText) const {
     return delta;
 }
 
-nlohmann::json DialogueManager::BuildFullPrompt(Character* character, const std::string& playerName) {
+nlohmann::json DialogueManager::BuildFullPrompt(Character* character, const std::string& playerName,
+                                                const std::string& stagePrompt) {
     nlohmann::json messages = nlohmann::json::array();
 
     // 1. 시스템 메시지 구성(구분자로 보호)
@@ -84,22 +395,18 @@ nlohmann::json DialogueManager::BuildFullPrompt(Character* character, const std:
     systemContent += "\n";
     systemContent += "Affection: " + std::to_string(character->GetAffection()) + "\n";
     
-    // 단계별 프롬프트를 파일에서 읽어 삽입
+    // 로스터가 읽어둔 단계별 프롬프트를 삽입
     int currentStage = character->GetRelationshipStage();
     std::string behaviorText = "Behavior: Default"; 
 
-    std::string promptPath = "data/characters/prompts/stage_" + std::to_string(currentStage) + ".txt";
-    std::ifstream pFile(promptPath);
-    if (pFile.is_open()) {
-        std::stringstream buffer;
-        buffer << pFile.rdbuf();
-        behaviorText = buffer.str();
-        
+    if (!stagePrompt.empty()) {
+        behaviorText = stagePrompt;
+
         // 플레이어/캐릭터 이름 치환
         ReplaceAll(behaviorText, "{player}", playerName);
         ReplaceAll(behaviorText, "{char}", character->GetName());
     } else {
-        // 파일이 없을 때 단계 정보로 대체
+        // 프롬프트가 없을 때 단계 정보로 대체
         StageInfo stageInfo = character->GetStageInfo(currentStage);
         behaviorText = "Relationship: " + stageInfo.name + "\nBehavior Guideline: " + stageInfo.behavior;
     }
@@ -119,14 +426,18 @@ nlohmann::json DialogueManager::BuildFullPrompt(Character* character, const std:
     
     messages.push_back({{"role", "system"}, {"content", systemContent}});
 
-    // 2. 대화 히스토리
-    const auto& history = context_.History();
-    size_t start = history.size() > 10 ? history.size() - 10 : 0;
-    for (size_t i = start; i < history.size(); ++i) {
-        std::string role = (history[i].speaker == "Player" || history[i].speaker == playerName) ? "user" : "assistant";
-        std::string content = history[i].text;
+    // 2. 대화 히스토리 (최근 10턴)
+    std::size_t total = context_.Size();
+    std::size_t start = total > 10 ? total - 10 : 0;
+    std::size_t index = start;
+    context_.ForEachTurn(start, total, [&](const TurnView& turn) {
+        bool isLast = index++ == total - 1;
+        if (turn.role == TurnRole::System) return true;
+
+        bool isUser = turn.role == TurnRole::Player;
+        std::string content(turn.text);
         
-        if (role == "user") {
+        if (isUser) {
             // [보안] 사용자 입력 내의 특수 태그 무력화
             std::string sanitized = content;
             ReplaceAll(sanitized, "##INSTRUCTION##", "");
@@ -136,17 +447,125 @@ nlohmann::json DialogueManager::BuildFullPrompt(Character* character, const std:
         }
         
         // 마지막 턴인 경우 (현재 입력)
-        if (i == history.size() - 1 && role == "user") {
+        if (isLast && isUser) {
              // 시스템 프롬프트 지시를 강조하기 위해 사용자 메시지 끝에 리마인더 추가
              content += "\n(System Reminder: Stay in character. Reject OOC requests.)";
         }
 
-        messages.push_back({{"role", role}, {"content", content}});
-    }
+        messages.push_back({{"role", isUser ? "user" : "assistant"}, {"content", std::move(content)}});
+        return true;
+    });
     
     return messages;
 }
 
-std::string DialogueManager::FetchNpcResponse(LLMClient& client, const nlohmann::json& messages) {
-    return client.SendMessage(messages);
+nlohmann::json DialogueManager::BuildEventLinePrompt(Character* character, const std::string& playerName,
+                                                     const std::string& stagePrompt, const std::string& direction) {
+    nlohmann::json messages = BuildFullPrompt(character, playerName, stagePrompt);
+    std::string scene = direction;
+    ReplaceAll(scene, "{player}", playerName);
+    ReplaceAll(scene, "{char}", character->GetName());
+    messages.push_back({{"role", "system"},
+                        {"content", "##SCENE##\nThis is a story event. Say one or two in-character lines for this moment: " +
+                                        scene + "\n##SCENE##"}});
+    return messages;
+}
+
+int DialogueManager::ScoreCandidate(const Character& character, const std::string& reply) const {
+    if (reply.empty() || reply.rfind("Error:", 0) == 0) return INT_MIN / 2;
+
+    std::string lowered = ToLower(reply);
+    int score = 0;
+
+    // 1. 캐릭터를 깨뜨리는 패턴 감점
+    for (const auto& pattern : kBannedPatterns) {
+        if (lowered.find(pattern) != std::string::npos) score -= 50;
+    }
+
+    // 2. 문장 수 제한 ("N문장 이내") 초과분 감점
+    const auto& traits = character.GetTraits();
+    int limit = ParseSentenceLimit(traits);
+    if (limit > 0) {
+        int over = CountSentences(reply) - limit;
+        if (over > 0) score -= 15 * over;
+    }
+
+    // 3. 행동 묘사(* *)를 요구하는 특성이면 포함 여부 가점
+    bool wantsAction = std::any_of(traits.begin(), traits.end(), [](const std::string& t) {
+        return t.find("* *") != std::string::npos;
+    });
+    if (wantsAction && std::count(reply.begin(), reply.end(), '*') >= 2) score += 10;
+
+    // 4. 특성 키워드와 겹치는 만큼 가점
+    for (const auto& keyword : ExtractTraitKeywords(traits)) {
+        if (lowered.find(keyword) != std::string::npos) score += 3;
+    }
+    return score;
+}
+
+double NpcReply::TimeToFirstToken() const {
+    if (chunks_ == 0) return -1.0;
+    return std::chrono::duration<double>(firstToken_ - started_).count();
+}
+
+double NpcReply::TokensPerSecond() const {
+    if (chunks_ == 0) return -1.0;
+    int tokens = usage_.completionTokens >= 0 ? usage_.completionTokens : chunks_;
+    // 첫 조각부터 잰 구간에는 조각 사이 간격이 (조각 수 - 1)개 들어 있습니다.
+    // 조각이 하나뿐이면(후보 모드, OpenAI) 요청 시각부터 잽니다.
+    double seconds = std::chrono::duration<double>(lastToken_ - firstToken_).count();
+    if (chunks_ > 1 && seconds > 0.0) return (tokens - 1) / seconds;
+    seconds = std::chrono::duration<double>(lastToken_ - started_).count();
+    return seconds > 0.0 ? tokens / seconds : -1.0;
+}
+
+void NpcReply::MarkToken(Clock::time_point at) {
+    if (chunks_++ == 0) firstToken_ = at;
+    lastToken_ = at;
+}
+
+std::shared_ptr<NpcReply> DialogueManager::FetchNpcResponseAsync(LLMClient& client, const nlohmann::json& messages,
+                                                                 const Character& character,
+                                                                 const EventLoop::Poster& poster,
+                                                                 std::function<void(const std::string&)> onToken) {
+    auto reply = std::make_shared<NpcReply>();
+    client.RequestAsync(
+        messages, config_.GetCandidateCount(), std::chrono::milliseconds(config_.GetCandidateDeadlineMs()),
+        [reply, poster, onToken = std::move(onToken)](const std::string& token) {
+            if (reply->cancelled_) return false;
+            // 속도는 게임 스레드가 조각을 처리한 시각이 아니라 도착한 시각으로 잽니다.
+            poster.Post([reply, onToken, token, at = NpcReply::Clock::now()]() {
+                if (reply->cancelled_ || reply->done_) return;
+                reply->MarkToken(at);
+                reply->text_ += token;
+                if (onToken) onToken(token);
+            });
+            return true;
+        },
+        // 점수는 게임 스레드에서 매기며, 그동안 캐릭터가 바뀌어도 되도록 요청 시점의 사본을 씁니다.
+        [this, reply, poster, scorer = character](std::vector<std::string> candidates, LLMUsage usage) {
+            poster.Post([this, reply, scorer, candidates = std::move(candidates), usage, at = NpcReply::Clock::now()]() {
+                if (reply->cancelled_) return;
+                if (reply->chunks_ == 0) reply->MarkToken(at);
+                reply->text_ = PickBest(scorer, candidates);
+                reply->usage_ = usage;
+                reply->done_ = true;
+            });
+        },
+        [reply]() { return reply->cancelled_.load(); });
+    return reply;
+}
+
+std::string DialogueManager::PickBest(const Character& character, const std::vector<std::string>& candidates) const {
+    if (candidates.size() == 1) return candidates.front();
+    size_t bestIndex = 0;
+    int bestScore = INT_MIN;
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        int score = ScoreCandidate(character, candidates[i]);
+        if (score > bestScore) {
+            bestScore = score;
+            bestIndex = i;
+        }
+    }
+    return candidates.empty() ? std::string("Error: No candidate replies") : candidates[bestIndex];
 }
@@ -1,37 +1,187 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 #include <nlohmann/json.hpp>
 
+#include "EventLoop.h"
+#include "LLMUsage.h"
+
 class TUI;
 class LLMClient;
 class Config;
 class Character;
+class DialogueLog;
+
+// 대화 턴을 말한 쪽의 역할입니다.
+enum class TurnRole : std::uint8_t {
+    Player,
+    Npc,
+    System
+};
 
 /**
  * 히스토리 관리를 위한 단일 대화 턴(Turn)입니다.
+ * 본문과 화자 이름은 DialogueContext가 소유하고, 턴은 위치와 ID만 가지는 고정 크기 레코드입니다.
  */
 struct DialogueTurn {
-    std::string speaker;
-    std::string text;
+    std::int64_t timestamp;      // 발화 시각 (유닉스 시간, 초)
+    std::uint32_t textOffset;    // 텍스트 아레나 내 본문 시작 위치
+    std::uint32_t textLength;    // 본문 길이 (바이트)
+    std::uint32_t tokenCount;    // 추정 토큰 수
+    std::uint16_t speakerId;     // 인터닝된 화자 ID
+    std::int8_t affectionDelta;  // 이 턴으로 인한 호감도 변화량
+    TurnRole role;
+};
+
+/**
+ * 메모리 창 또는 디스크 로그에 있는 턴을 읽기 전용으로 보여주는 뷰입니다.
+ * 문자열 뷰는 콜백이 반환되기 전까지만 유효합니다.
+ */
+struct TurnView {
+    TurnRole role;
+    std::string_view speaker;
+    std::string_view text;
+    std::int64_t timestamp;
+    std::uint32_t tokenCount;
+    int affectionDelta;
 };
 
 /**
  * 프롬프트 및 저장을 위한 대화 기록을 관리합니다.
+ * 최근 턴은 고정 크기 링 버퍼(hot window)에 두고, 넘치는 오래된 턴은 디스크 로그로 내보냅니다.
+ * 모든 본문은 하나의 연속된 문자열 아레나에 이어 붙여 저장합니다.
+ *
+ * 복사는 저장소를 공유하는 O(1) 스냅샷이며, 어느 쪽이든 수정하기 직전에만 실제로 복사합니다.
+ * (copy-on-write) 따라서 저장 스레드에 넘긴 스냅샷은 게임 스레드가 계속 대화를 이어가도 바뀌지 않습니다.
+ * 미뤄 둔 복원(Defer)은 복사하기 전에 원본에서 실행하므로, 스냅샷이 다른 스레드에서 로더를 돌리는 일은 없습니다.
  */
 struct DialogueContext {
-    // 히스토리에 새로운 발화 턴을 추가합니다.
-    void AddTurn(const std::string& speaker, const std::string& text);
+    DialogueContext();
+    DialogueContext(const DialogueContext& other);
+    DialogueContext& operator=(const DialogueContext& other);
+    ~DialogueContext();
+
+    // 메모리에 유지할 최근 턴 수와 넘치는 턴을 내보낼 로그 경로를 설정합니다. (0이면 무제한)
+    void Configure(std::size_t hotCapacity, std::string spillPath);
+
+    // 히스토리에 새로운 발화 턴을 추가합니다. `timestamp`가 0이면 현재 시각을 사용합니다.
+    void AddTurn(TurnRole role, const std::string& speaker, std::string_view text,
+                 int affectionDelta = 0, std::int64_t timestamp = 0);
     
     // 기록된 모든 턴을 지웁니다.
     void Clear();
 
-    // 전체 턴 리스트를 반환합니다.
-    const std::vector<DialogueTurn>& History() const;
+    // 히스토리 복원을 실제로 필요해질 때(턴 조회/추가)까지 미룹니다. 등록 순서대로 한 번만 실행됩니다.
+    // `turns`는 로더가 추가할 턴 수이며, Size()는 로더를 실행하지 않고 이 값을 더해 답합니다.
+    void Defer(std::function<void(DialogueContext&)> loader, std::size_t turns);
+
+    // 디스크로 내보낸 턴과 미뤄 둔 턴을 포함한 전체 턴 수를 반환합니다. (복원을 일으키지 않음)
+    // 미뤄 둔 기록이 손상되어 일부만 복원되면 복원 뒤의 값은 더 작아질 수 있습니다.
+    std::size_t Size() const;
+
+    // 메모리에 남아 있는 가장 오래된 턴의 인덱스를 반환합니다.
+    std::size_t HotBegin() const;
+
+    // 메모리에 있는 턴을 반환합니다. (HotBegin() <= index < Size())
+    const DialogueTurn& At(std::size_t index) const;
+
+    // 턴의 본문을 반환합니다. (아레나를 가리키므로 다음 AddTurn 전까지만 유효)
+    std::string_view Text(const DialogueTurn& turn) const;
+
+    // 턴의 화자 이름을 반환합니다.
+    const std::string& Speaker(const DialogueTurn& turn) const;
+
+    // [begin, end) 구간의 턴을 순서대로 방문합니다. 디스크에 있는 턴은 필요한 만큼만 읽습니다.
+    // `fn`이 false를 반환하면 순회를 중단합니다.
+    void ForEachTurn(std::size_t begin, std::size_t end, const std::function<bool(const TurnView&)>& fn) const;
+
+    // 본문에 `needle`이 포함된 턴의 인덱스를 최신 순으로 최대 `maxResults`개 반환합니다.
+    std::vector<std::size_t> Search(std::string_view needle, std::size_t maxResults) const;
+
+private:
+    // 스냅샷끼리 공유하는 실제 저장소입니다.
+    struct Storage {
+        std::vector<DialogueTurn> ring;
+        std::size_t head = 0;
+        std::size_t count = 0;
+        std::size_t spilled = 0;
+
+        std::string arena;
+        std::vector<std::string> speakers;
+        std::unordered_map<std::string, std::uint16_t> speakerIds;
+    };
+
+    // 다른 스냅샷과 저장소를 공유 중이면 복사한 뒤 수정 가능한 저장소를 반환합니다.
+    Storage& Mutable();
+    std::uint16_t InternSpeaker(Storage& storage, const std::string& name);
+    // 가장 오래된 턴을 디스크 로그로 내보냅니다. 기록하지 못하면 턴을 그대로 두고 false를 반환합니다.
+    bool SpillOldest(Storage& storage);
+
+    // 다른 스냅샷과 공유하던 로그 대신, 지금까지 내보낸 턴을 옮긴 새 세대의 로그를 만들어 씁니다.
+    bool ForkSpill(const Storage& storage);
+    void Materialize() const;
+
+    std::shared_ptr<Storage> storage_;
+    std::size_t capacity_;
+
+    // 디스크 로그는 추가 전용이므로 스냅샷과 공유해도 안전합니다. (스냅샷은 자신의 spilled 수까지만 읽음)
+    // 덧붙이는 것은 로그를 만든 쪽뿐이며, 복사본이 내보내야 하면 ForkSpill로 자신의 로그를 만듭니다.
+    std::string spillPath_;
+    std::shared_ptr<DialogueLog> spill_;
+    bool ownsSpill_ = true;
+
+    mutable std::vector<std::function<void(DialogueContext&)>> deferred_;
+    mutable std::size_t deferredTurns_ = 0;  // 미뤄 둔 로더가 추가할 턴 수
+};
+
+/**
+ * 비동기로 받는 NPC 응답 하나입니다. 게임 스레드에서만 읽고 씁니다.
+ * 요청 스레드가 받은 조각과 결과는 이벤트 루프를 거쳐 들어오며, Cancel() 이후에 도착한 것은 버려집니다.
+ */
+class NpcReply {
+public:
+    bool Done() const { return done_; }
+    bool Cancelled() const { return cancelled_; }
+
+    // 지금까지 받은 본문입니다. 끝나면 최종 응답(후보 중 고른 것 또는 "Error: ...")이 됩니다.
+    const std::string& Text() const { return text_; }
+
+    // 응답을 더 기다리지 않습니다. 스트리밍 중이면 요청 스레드가 다음 조각에서 요청을 멈춥니다.
+    void Cancel() { cancelled_ = true; }
+
+    // 끝난 뒤 API가 알려준 토큰 수입니다. (끝나기 전이나 알려주지 않은 값은 -1)
+    const LLMUsage& Usage() const { return usage_; }
+
+    // 요청부터 첫 조각(후보 모드에서는 응답)이 도착하기까지 걸린 초입니다. 아직이면 음수입니다.
+    double TimeToFirstToken() const;
+
+    // 지금까지의 생성 속도(토큰/초)입니다. 토큰 수를 모르는 동안은 받은 조각 수로 어림합니다. 아직이면 음수입니다.
+    double TokensPerSecond() const;
 
 private:
-    std::vector<DialogueTurn> history_;
+    friend class DialogueManager;
+    using Clock = std::chrono::steady_clock;
+
+    // 요청 스레드에서 조각이 도착한 시각을 기록합니다.
+    void MarkToken(Clock::time_point at);
+
+    std::atomic<bool> cancelled_{false};  // 요청 스레드도 읽습니다.
+    bool done_ = false;
+    std::string text_;
+
+    Clock::time_point started_ = Clock::now();
+    Clock::time_point firstToken_;
+    Clock::time_point lastToken_;
+    int chunks_ = 0;
+    LLMUsage usage_;
 };
 
 /**
@@ -48,12 +198,27 @@ public:
     int ScoreAffectionDelta(const std::string& userText) const;
 
     // LLM 전송용 전체 JSON 페이로드(시스템 + 히스토리 + 사용자 입력)를 생성합니다.
-    nlohmann::json BuildFullPrompt(Character* character, const std::string& playerName);
+    // `stagePrompt`가 비어 있으면 캐릭터의 단계 정보로 행동 지침을 만듭니다.
+    nlohmann::json BuildFullPrompt(Character* character, const std::string& playerName, const std::string& stagePrompt);
+
+    // 이벤트 스크립트의 generate 노드용 메시지를 만듭니다. (연출 지시를 시스템 메시지로 덧붙임)
+    nlohmann::json BuildEventLinePrompt(Character* character, const std::string& playerName,
+                                        const std::string& stagePrompt, const std::string& direction);
     
-    // LLM으로부터 응답을 받아 반환합니다. (출력은 TUI가 담당)
-    std::string FetchNpcResponse(LLMClient& client, const nlohmann::json& messages);
+    // 후보 응답이 캐릭터 설정에 얼마나 부합하는지 점수를 매깁니다. (높을수록 좋음)
+    int ScoreCandidate(const Character& character, const std::string& reply) const;
+
+    // LLM 응답을 별도 스레드에서 요청하고 바로 반환합니다. (출력은 TUI가 담당)
+    // 받은 조각은 `poster`를 거쳐 게임 스레드에서 본문에 이어 붙이고 `onToken`으로 알립니다.
+    // 설정된 후보 수가 2 이상이면 조각 없이 여러 후보를 모두 받은 뒤 캐릭터에 가장 잘 맞는 응답을 고릅니다.
+    std::shared_ptr<NpcReply> FetchNpcResponseAsync(LLMClient& client, const nlohmann::json& messages,
+                                                    const Character& character, const EventLoop::Poster& poster,
+                                                    std::function<void(const std::string&)> onToken = nullptr);
 
 private:
+    // 후보 중 ScoreCandidate 점수가 가장 높은 응답을 고릅니다.
+    std::string PickBest(const Character& character, const std::vector<std::string>& candidates) const;
+
     const Config& config_;
     DialogueContext context_;
 };
@@ -7,13 +7,18 @@
 
 /**
  * 호감도 임계값 이벤트 정의를 나타냅니다.
+ * `condition`이 있으면 임계값과 함께 조건식도 만족해야 발생합니다. (문법은 EventCondition 참고)
+ * `script`가 있으면 `lines` 대신 분기 스크립트를 재생합니다. (형식은 DialogueGraph 참고)
  */
 struct Event {
     std::string id;
     int threshold = 0;
     std::string title;
     std::vector<std::string> lines;
+    std::string condition;              // 비어 있으면 임계값만 봅니다.
+    std::vector<std::string> setFlags;  // 발생하면 켜는 플래그 (다른 이벤트의 flag("...") 조건에 쓰임)
+    nlohmann::json script;              // 분기 스크립트 원본 (EventEngine이 컴파일한 뒤 비움)
 
-    // 런타임에 로드된 JSON 데이터로부터 Event 객체를 생성합니다.
-    NLOHMANN_DEFINE_TYPE_INTRUSIVE(Event, id, threshold, title, lines)
+    // 런타임에 로드된 JSON 데이터로부터 Event 객체를 생성합니다. (없는 키는 기본값)
+    NLOHMANN_DEFINE_TYPE_INTRUSIVE_WITH_DEFAULT(Event, id, threshold, title, lines, condition, setFlags, script)
 };
@@ -0,0 +1,269 @@
+#include "EventCondition.h"
+
+#include <algorithm>
+#include <cctype>
+
+namespace {
+// 평가 스택의 크기이자 식의 최대 중첩 깊이입니다. 깊이를 막아 두면 파서의 재귀도 이 안에서 끝납니다.
+constexpr std::size_t kMaxStack = 64;
+}  // 익명 네임스페이스 종료
+
+std::uint32_t ConditionSymbols::InternKeyword(const std::string& keyword) {
+    auto [it, inserted] = keywordIndex.emplace(keyword, static_cast<std::uint32_t>(keywords.size()));
+    if (inserted) keywords.push_back(keyword);
+    return it->second;
+}
+
+std::uint32_t ConditionSymbols::InternFlag(const std::string& flag) {
+    auto [it, inserted] = flagIndex.emplace(flag, static_cast<std::uint32_t>(flags.size()));
+    if (inserted) flags.push_back(flag);
+    return it->second;
+}
+
+/**
+ * 재귀 하강 방식으로 조건식을 읽으며 후위 순서의 바이트코드를 만듭니다.
+ */
+class ConditionParser {
+public:
+    ConditionParser(const std::string& source, ConditionSymbols& symbols, EventCondition& out)
+        : src_(source), symbols_(symbols), out_(out), pos_(0), depth_(0) {}
+
+    bool Parse(std::string& error) {
+        bool ok = ParseOr();
+        SkipSpace();
+        if (ok && pos_ != src_.size()) ok = Fail("식이 끝나야 합니다");
+        if (!ok) error = error_ + " (위치 " + std::to_string(errorPos_) + ")";
+        return ok;
+    }
+
+private:
+    using Op = EventCondition::Op;
+
+    bool ParseOr() {
+        if (!ParseAnd()) return false;
+        while (Match("||")) {
+            if (!ParseAnd()) return false;
+            Emit(Op::Or);
+        }
+        return true;
+    }
+
+    bool ParseAnd() {
+        if (!ParseNot()) return false;
+        while (Match("&&")) {
+            if (!ParseNot()) return false;
+            Emit(Op::And);
+        }
+        return true;
+    }
+
+    bool ParseNot() {
+        SkipSpace();
+        // "!="와 구분하기 위해 '!' 뒤에 '='가 오지 않을 때만 부정으로 읽습니다.
+        if (pos_ < src_.size() && src_[pos_] == '!' && (pos_ + 1 >= src_.size() || src_[pos_ + 1] != '=')) {
+            ++pos_;
+            if (!Enter()) return false;
+            bool ok = ParseNot();
+            --depth_;
+            if (!ok) return false;
+            Emit(Op::Not);
+            return true;
+        }
+        return ParseComparison();
+    }
+
+    bool ParseComparison() {
+        if (!ParseTerm()) return false;
+        static const std::pair<const char*, Op> kComparisons[] = {
+            {"<=", Op::Le}, {">=", Op::Ge}, {"==", Op::Eq}, {"!=", Op::Ne}, {"<", Op::Lt}, {">", Op::Gt}};
+        for (const auto& [token, op] : kComparisons) {
+            if (Match(token)) {
+                if (!ParseTerm()) return false;
+                Emit(op);
+                return true;
+            }
+        }
+        return true;
+    }
+
+    bool ParseTerm() {
+        SkipSpace();
+        if (pos_ >= src_.size()) return Fail("값이 필요합니다");
+
+        char ch = src_[pos_];
+        if (ch == '(') {
+            ++pos_;
+            if (!Enter()) return false;
+            bool ok = ParseOr();
+            --depth_;
+            if (!ok) return false;
+            return Match(")") || Fail("')'가 필요합니다");
+        }
+        if (std::isdigit(static_cast<unsigned char>(ch)) || ch == '-') {
+            std::size_t start = pos_++;
+            while (pos_ < src_.size() && std::isdigit(static_cast<unsigned char>(src_[pos_]))) ++pos_;
+            if (pos_ - start == 1 && ch == '-') return Fail("숫자가 필요합니다");
+            if (pos_ - start > 9) return Fail("숫자가 너무 큽니다");
+            Emit(Op::PushConst, std::stoi(src_.substr(start, pos_ - start)));
+            return true;
+        }
+        if (std::isalpha(static_cast<unsigned char>(ch)) || ch == '_') {
+            std::size_t start = pos_;
+            while (pos_ < src_.size() && (std::isalnum(static_cast<unsigned char>(src_[pos_])) || src_[pos_] == '_')) {
+                ++pos_;
+            }
+            return ParseIdentifier(src_.substr(start, pos_ - start));
+        }
+        return Fail(std::string("예상하지 못한 문자 '") + ch + "'");
+    }
+
+    bool ParseIdentifier(const std::string& name) {
+        static const std::pair<const char*, ConditionInputs::Variable> kVariables[] = {
+            {"affection", ConditionInputs::Affection},
+            {"stage", ConditionInputs::Stage},
+            {"turns", ConditionInputs::Turns},
+            {"hour", ConditionInputs::Hour}};
+        for (const auto& [variable, index] : kVariables) {
+            if (name == variable) {
+                Emit(Op::LoadVar, static_cast<std::int32_t>(index));
+                Depend(index);
+                return true;
+            }
+        }
+        if (name == "true" || name == "false") {
+            Emit(Op::PushConst, name == "true" ? 1 : 0);
+            return true;
+        }
+        if (name == "said" || name == "flag") {
+            std::string argument;
+            if (!Match("(") || !ParseString(argument) || !Match(")")) {
+                return Fail(name + "(\"...\") 형식이어야 합니다");
+            }
+            if (name == "said") {
+                std::uint32_t keyword = symbols_.InternKeyword(argument);
+                Emit(Op::Said, static_cast<std::int32_t>(keyword));
+                Depend(EventCondition::KeywordDependency(keyword));
+            } else {
+                std::uint32_t flag = symbols_.InternFlag(argument);
+                Emit(Op::Flag, static_cast<std::int32_t>(flag));
+                Depend(EventCondition::FlagDependency(flag));
+            }
+            return true;
+        }
+        return Fail("알 수 없는 이름 '" + name + "'");
+    }
+
+    bool ParseString(std::string& out) {
+        SkipSpace();
+        if (pos_ >= src_.size() || src_[pos_] != '"') return false;
+        std::size_t end = src_.find('"', pos_ + 1);
+        if (end == std::string::npos) return false;
+        out = src_.substr(pos_ + 1, end - pos_ - 1);
+        pos_ = end + 1;
+        return !out.empty();
+    }
+
+    void SkipSpace() {
+        while (pos_ < src_.size() && std::isspace(static_cast<unsigned char>(src_[pos_]))) ++pos_;
+    }
+
+    bool Match(const char* token) {
+        SkipSpace();
+        std::size_t length = std::char_traits<char>::length(token);
+        if (src_.compare(pos_, length, token) != 0) return false;
+        pos_ += length;
+        return true;
+    }
+
+    // 괄호나 '!'로 한 단계 더 들어갑니다. 너무 깊은 식은 재귀가 스택을 넘기기 전에 거절합니다.
+    bool Enter() {
+        if (depth_ >= kMaxStack) return Fail("식이 너무 깊습니다");
+        ++depth_;
+        return true;
+    }
+
+    bool Fail(const std::string& message) {
+        if (error_.empty()) {
+            error_ = message;
+            errorPos_ = pos_;
+        }
+        return false;
+    }
+
+    void Emit(Op op, std::int32_t operand = 0) {
+        out_.code_.push_back({op, operand});
+    }
+
+    void Depend(std::uint32_t dependency) {
+        auto& deps = out_.dependencies_;
+        if (std::find(deps.begin(), deps.end(), dependency) == deps.end()) deps.push_back(dependency);
+    }
+
+    const std::string& src_;
+    ConditionSymbols& symbols_;
+    EventCondition& out_;
+    std::size_t pos_;
+    std::size_t depth_;  // 현재 중첩 깊이
+    std::string error_;
+    std::size_t errorPos_ = 0;
+};
+
+bool EventCondition::Compile(const std::string& source, ConditionSymbols& symbols, EventCondition& out,
+                             std::string& error) {
+    out.code_.clear();
+    out.dependencies_.clear();
+    ConditionParser parser(source, symbols, out);
+    if (!parser.Parse(error)) {
+        out.code_.clear();
+        out.dependencies_.clear();
+        return false;
+    }
+    return true;
+}
+
+bool EventCondition::Evaluate(const ConditionInputs& inputs) const {
+    // 식의 깊이는 파서가 제한하므로 스택은 고정 크기 배열로 둡니다. (넘치면 거짓으로 처리)
+    std::int32_t stack[kMaxStack];
+    std::size_t top = 0;
+
+    auto bit = [](const std::vector<bool>* bits, std::int32_t index) {
+        return bits && static_cast<std::size_t>(index) < bits->size() && (*bits)[static_cast<std::size_t>(index)];
+    };
+
+    for (const Instruction& in : code_) {
+        switch (in.op) {
+            case Op::PushConst:
+            case Op::LoadVar:
+            case Op::Said:
+            case Op::Flag: {
+                if (top == kMaxStack) return false;
+                std::int32_t value = in.operand;
+                if (in.op == Op::LoadVar) value = inputs.variables[in.operand];
+                else if (in.op == Op::Said) value = bit(inputs.said, in.operand);
+                else if (in.op == Op::Flag) value = bit(inputs.flags, in.operand);
+                stack[top++] = value;
+                break;
+            }
+            case Op::Not:
+                stack[top - 1] = !stack[top - 1];
+                break;
+            default: {
+                std::int32_t rhs = stack[--top];
+                std::int32_t& lhs = stack[top - 1];
+                switch (in.op) {
+                    case Op::Lt: lhs = lhs < rhs; break;
+                    case Op::Le: lhs = lhs <= rhs; break;
+                    case Op::Gt: lhs = lhs > rhs; break;
+                    case Op::Ge: lhs = lhs >= rhs; break;
+                    case Op::Eq: lhs = lhs == rhs; break;
+                    case Op::Ne: lhs = lhs != rhs; break;
+                    case Op::And: lhs = lhs && rhs; break;
+                    case Op::Or: lhs = lhs || rhs; break;
+                    default: break;
+                }
+                break;
+            }
+        }
+    }
+    return top == 1 && stack[0] != 0;
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * 조건식이 참조하는 키워드와 플래그 이름을 번호로 바꾸는 표입니다. 이벤트 묶음 하나가 공유합니다.
+ */
+struct ConditionSymbols {
+    std::vector<std::string> keywords;
+    std::vector<std::string> flags;
+    std::unordered_map<std::string, std::uint32_t> keywordIndex;
+    std::unordered_map<std::string, std::uint32_t> flagIndex;
+
+    std::uint32_t InternKeyword(const std::string& keyword);
+    std::uint32_t InternFlag(const std::string& flag);
+};
+
+/**
+ * 조건식을 평가할 때 쓰는 현재 상태입니다.
+ */
+struct ConditionInputs {
+    enum Variable : std::uint32_t {
+        Affection = 0,
+        Stage,
+        Turns,
+        Hour,
+        VariableCount
+    };
+
+    int variables[VariableCount] = {};
+    const std::vector<bool>* said = nullptr;   // 키워드 번호별로 플레이어가 말한 적이 있는지
+    const std::vector<bool>* flags = nullptr;  // 플래그 번호별로 켜져 있는지
+};
+
+/**
+ * 이벤트 발생 조건식을 바이트코드로 컴파일해 평가합니다.
+ *
+ * 문법: `affection >= 50 && (stage == 2 || said("바다")) && !flag("confessed")`
+ * - 변수: affection, stage, turns(주고받은 대화 수), hour(현재 시각 0~23)
+ * - 함수: said("키워드") 플레이어가 한 번이라도 말했는지, flag("이름") 이벤트가 켠 플래그
+ * - 연산자: 비교(< <= > >= == !=), 논리(! && ||), 괄호, 정수 상수
+ *
+ * 컴파일할 때 식이 읽는 입력(변수, 키워드, 플래그)을 의존성 번호로 모아 두므로,
+ * 호출 측은 입력이 바뀐 조건만 다시 평가할 수 있습니다.
+ */
+class EventCondition {
+public:
+    // 의존성 번호: 변수는 변수 번호 그대로, 키워드와 플래그는 상위 비트에 종류를 표시합니다.
+    static std::uint32_t KeywordDependency(std::uint32_t keyword) { return kKeywordTag | keyword; }
+    static std::uint32_t FlagDependency(std::uint32_t flag) { return kFlagTag | flag; }
+
+    // 식을 컴파일합니다. 문법 오류면 false를 반환하고 error에 위치와 이유를 씁니다.
+    static bool Compile(const std::string& source, ConditionSymbols& symbols, EventCondition& out, std::string& error);
+
+    // 조건을 평가합니다.
+    bool Evaluate(const ConditionInputs& inputs) const;
+
+    // 식이 읽는 입력의 의존성 번호를 반환합니다. (중복 없음)
+    const std::vector<std::uint32_t>& Dependencies() const { return dependencies_; }
+
+private:
+    static constexpr std::uint32_t kKeywordTag = 1u << 30;
+    static constexpr std::uint32_t kFlagTag = 2u << 30;
+
+    enum class Op : std::uint8_t {
+        PushConst,
+        LoadVar,
+        Said,
+        Flag,
+        Lt, Le, Gt, Ge, Eq, Ne,
+        And, Or, Not
+    };
+
+    struct Instruction {
+        Op op;
+        std::int32_t operand;
+    };
+
+    friend class ConditionParser;
+
+    std::vector<Instruction> code_;
+    std::vector<std::uint32_t> dependencies_;
+};
@@ -0,0 +1,234 @@
+#include "EventEngine.h"
+
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+
+#include "Character.h"
+
+namespace {
+constexpr std::size_t kWordBits = 64;
+
+void SetBit(std::vector<std::uint64_t>& bits, std::size_t index) {
+    bits[index / kWordBits] |= std::uint64_t{1} << (index % kWordBits);
+}
+}  // 익명 네임스페이스 종료
+
+EventEngine::EventEngine(std::vector<Event> events) : events_(std::move(events)) {
+    for (std::size_t i = 0; i < events_.size(); ++i) {
+        if (events_[i].id.empty()) {
+            events_[i].id = "@" + std::to_string(events_[i].threshold) + "#" + std::to_string(i);
+        }
+    }
+    // 같은 임계값끼리는 파일에 적힌 순서를 유지합니다.
+    std::stable_sort(events_.begin(), events_.end(),
+                     [](const Event& a, const Event& b) { return a.threshold < b.threshold; });
+
+    index_.reserve(events_.size());
+    for (std::size_t i = 0; i < events_.size(); ++i) {
+        index_.emplace(events_[i].id, i);
+    }
+    firstAutomatic_ = static_cast<std::size_t>(
+        std::find_if(events_.begin(), events_.end(), [](const Event& e) { return e.threshold > 0; }) -
+        events_.begin());
+
+    conditionalMask_.assign((events_.size() + kWordBits - 1) / kWordBits, 0);
+    setFlags_.resize(events_.size());
+    scriptEntries_.resize(events_.size(), DialogueGraph::kEnd);
+    for (std::size_t i = 0; i < events_.size(); ++i) {
+        Event& event = events_[i];
+
+        // 스크립트가 잘못되었으면 알리고 기본 대사로 재생합니다.
+        if (!event.script.is_null()) {
+            std::string error;
+            scriptEntries_[i] = script_.AddScript(event.script, error);
+            if (scriptEntries_[i] == DialogueGraph::kEnd) {
+                std::cerr << "[EventEngine] 이벤트 스크립트 오류(" << event.id << "): " << error << '\n';
+            }
+        }
+        if (scriptEntries_[i] == DialogueGraph::kEnd) scriptEntries_[i] = script_.AddLines(event.lines);
+        event.script = nullptr;
+        std::vector<std::string>().swap(event.lines);
+
+        for (const std::string& flag : event.setFlags) {
+            setFlags_[i].push_back(symbols_.InternFlag(flag));
+        }
+        if (event.condition.empty()) continue;
+
+        SetBit(conditionalMask_, i);
+        EventCondition condition;
+        std::string error;
+        if (!EventCondition::Compile(event.condition, symbols_, condition, error)) {
+            std::cerr << "[EventEngine] 이벤트 조건식 오류(" << event.id << "): " << error << '\n';
+            continue;
+        }
+        auto slot = static_cast<std::uint32_t>(conditions_.size());
+        for (std::uint32_t dependency : condition.Dependencies()) {
+            dependents_[dependency].push_back(slot);
+        }
+        // 임계값이 있으면 조건식과 함께 만족해야 하므로(EventProgress::EvaluateSlot) 호감도가 바뀔 때도 다시 평가합니다.
+        if (event.threshold > 0) {
+            std::vector<std::uint32_t>& affection = dependents_[ConditionInputs::Affection];
+            if (std::find(affection.begin(), affection.end(), slot) == affection.end()) affection.push_back(slot);
+        }
+        conditions_.push_back(std::move(condition));
+        conditionEvents_.push_back(i);
+    }
+}
+
+std::size_t EventEngine::Find(const std::string& id) const {
+    auto it = index_.find(id);
+    return it == index_.end() ? npos : it->second;
+}
+
+const std::vector<std::uint32_t>& EventEngine::Dependents(std::uint32_t dependency) const {
+    static const std::vector<std::uint32_t> kNone;
+    auto it = dependents_.find(dependency);
+    return it == dependents_.end() ? kNone : it->second;
+}
+
+void EventProgress::Bind(const EventEngine* engine, Character& character) {
+    engine_ = engine;
+    fired_.clear();
+    reached_ = 0;
+    firstUnfired_ = 0;
+    said_.clear();
+    flags_.clear();
+    ready_.clear();
+    pendingChanges_.clear();
+    evaluatedAt_.clear();
+    round_ = 0;
+    evaluated_ = false;
+    if (!engine_) return;
+
+    fired_.assign((engine_->Size() + kWordBits - 1) / kWordBits, 0);
+    // 임계값으로만 기록하던 이전 세이브는 같은 임계값의 이벤트를 모두 발생한 것으로 옮깁니다.
+    for (int threshold : character.GetLegacyTriggeredThresholds()) {
+        for (std::size_t i = 0; i < engine_->Size(); ++i) {
+            if (engine_->At(i).threshold == threshold) character.MarkEventTriggered(engine_->At(i).id);
+        }
+    }
+    character.ClearLegacyTriggeredThresholds();
+
+    for (const std::string& id : character.GetTriggeredEvents()) {
+        std::size_t index = engine_->Find(id);
+        if (index != EventEngine::npos) SetBit(fired_, index);
+    }
+    reached_ = engine_->FirstAutomatic();
+    firstUnfired_ = NextUnfired(reached_);
+
+    const ConditionSymbols& symbols = engine_->Symbols();
+    said_.assign(symbols.keywords.size(), false);
+    for (std::size_t k = 0; k < symbols.keywords.size(); ++k) {
+        said_[k] = character.HasSaidKeyword(symbols.keywords[k]);
+    }
+    flags_.assign(symbols.flags.size(), false);
+    for (std::size_t f = 0; f < symbols.flags.size(); ++f) {
+        flags_[f] = character.HasFlag(symbols.flags[f]);
+    }
+    evaluatedAt_.assign(engine_->ConditionCount(), 0);
+}
+
+void EventProgress::NoteSaid(const std::string& text, Character& character) {
+    if (!engine_) return;
+    const std::vector<std::string>& keywords = engine_->Symbols().keywords;
+    for (std::size_t k = 0; k < keywords.size(); ++k) {
+        if (said_[k] || text.find(keywords[k]) == std::string::npos) continue;
+        said_[k] = true;
+        character.MarkKeywordSaid(keywords[k]);
+        pendingChanges_.push_back(EventCondition::KeywordDependency(static_cast<std::uint32_t>(k)));
+    }
+}
+
+std::vector<std::size_t> EventProgress::Due(ConditionInputs inputs) {
+    std::vector<std::size_t> due;
+    if (!engine_) return due;
+    inputs.said = &said_;
+    inputs.flags = &flags_;
+
+    // 커서는 호감도가 바뀐 만큼만 움직입니다.
+    int affection = inputs.variables[ConditionInputs::Affection];
+    while (reached_ < engine_->Size() && engine_->At(reached_).threshold <= affection) ++reached_;
+    while (reached_ > engine_->FirstAutomatic() && engine_->At(reached_ - 1).threshold > affection) --reached_;
+
+    for (std::size_t i = firstUnfired_; i < reached_; i = NextUnfired(i + 1)) {
+        due.push_back(i);
+    }
+
+    // 처음에는 모든 조건을, 이후에는 입력이 바뀐 조건만 평가합니다.
+    ++round_;
+    if (!evaluated_) {
+        for (std::size_t slot = 0; slot < engine_->ConditionCount(); ++slot) EvaluateSlot(slot, inputs);
+        evaluated_ = true;
+    } else {
+        for (std::uint32_t v = 0; v < ConditionInputs::VariableCount; ++v) {
+            if (inputs.variables[v] != lastVariables_[v]) Reevaluate(v, inputs);
+        }
+        for (std::uint32_t dependency : pendingChanges_) Reevaluate(dependency, inputs);
+    }
+    pendingChanges_.clear();
+    std::copy(std::begin(inputs.variables), std::end(inputs.variables), std::begin(lastVariables_));
+
+    if (!ready_.empty()) {
+        std::vector<std::size_t> merged;
+        merged.reserve(due.size() + ready_.size());
+        std::merge(due.begin(), due.end(), ready_.begin(), ready_.end(), std::back_inserter(merged));
+        due = std::move(merged);
+    }
+    return due;
+}
+
+void EventProgress::MarkFired(std::size_t index, Character& character) {
+    if (!engine_ || index >= engine_->Size() || IsFired(index)) return;
+    SetBit(fired_, index);
+    character.MarkEventTriggered(engine_->At(index).id);
+    if (index == firstUnfired_) firstUnfired_ = NextUnfired(index + 1);
+    ready_.erase(index);
+
+    for (std::uint32_t flag : engine_->FlagsSetBy(index)) {
+        if (flags_[flag]) continue;
+        flags_[flag] = true;
+        character.SetFlag(engine_->Symbols().flags[flag]);
+        pendingChanges_.push_back(EventCondition::FlagDependency(flag));
+    }
+}
+
+bool EventProgress::IsFired(std::size_t index) const {
+    return (fired_[index / kWordBits] >> (index % kWordBits)) & 1u;
+}
+
+std::size_t EventProgress::NextUnfired(std::size_t from) const {
+    // 발생했거나 조건식으로 판단하는 이벤트만 있는 워드는 한 번에 건너뜁니다.
+    const std::vector<std::uint64_t>& conditional = engine_->ConditionalMask();
+    std::size_t size = engine_->Size();
+    while (from < size) {
+        std::size_t word = from / kWordBits;
+        std::uint64_t open = ~(fired_[word] | conditional[word]) >> (from % kWordBits);
+        if (open != 0) {
+            std::size_t bit = 0;
+            while (!((open >> bit) & 1u)) ++bit;
+            return std::min(size, from + bit);
+        }
+        from = (word + 1) * kWordBits;
+    }
+    return size;
+}
+
+void EventProgress::Reevaluate(std::uint32_t dependency, const ConditionInputs& inputs) {
+    for (std::uint32_t slot : engine_->Dependents(dependency)) {
+        if (evaluatedAt_[slot] != round_) EvaluateSlot(slot, inputs);
+    }
+}
+
+void EventProgress::EvaluateSlot(std::size_t slot, const ConditionInputs& inputs) {
+    evaluatedAt_[slot] = round_;
+    std::size_t index = engine_->ConditionEvent(slot);
+    // 임계값은 조건식에 덧붙여 컴파일하지 않고 따로 비교합니다. (덧붙이면 중첩 한도에 걸릴 수 있음)
+    int threshold = engine_->At(index).threshold;
+    bool reached = threshold <= 0 || inputs.variables[ConditionInputs::Affection] >= threshold;
+    if (!IsFired(index) && reached && engine_->Condition(slot).Evaluate(inputs)) {
+        ready_.insert(index);
+    } else {
+        ready_.erase(index);
+    }
+}
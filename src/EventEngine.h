@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "DialogueGraph.h"
+#include "Event.h"
+#include "EventCondition.h"
+
+class Character;
+
+/**
+ * 캐릭터의 이벤트 묶음을 호감도 임계값 순으로 정렬해 id로 색인한 표입니다. (읽기 전용)
+ * id가 없는 이벤트에는 임계값과 원래 순서로 만든 id를 붙여 서로 겹치지 않게 합니다.
+ *
+ * 조건식이 있는 이벤트는 불러올 때 바이트코드로 컴파일하고, 조건이 읽는 입력마다
+ * 그 입력에 의존하는 조건 목록을 만들어 둡니다. 컴파일에 실패한 이벤트는 발생하지 않습니다.
+ * 이벤트 대사(`script` 또는 `lines`)도 하나의 대화 그래프로 컴파일하며, 원본 대사는 컴파일 후 비웁니다.
+ */
+class EventEngine {
+public:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    EventEngine() = default;
+    explicit EventEngine(std::vector<Event> events);
+
+    // 이벤트 수를 반환합니다.
+    std::size_t Size() const { return events_.size(); }
+
+    // 정렬된 위치의 이벤트를 반환합니다.
+    const Event& At(std::size_t index) const { return events_[index]; }
+
+    // id에 해당하는 위치를 반환합니다. 없으면 npos를 반환합니다.
+    std::size_t Find(const std::string& id) const;
+
+    // 호감도로 자동 발생하는 첫 이벤트(임계값 > 0)의 위치를 반환합니다.
+    std::size_t FirstAutomatic() const { return firstAutomatic_; }
+
+    // 임계값만으로 판단하지 않는 이벤트(조건식이 있거나 컴파일에 실패한 이벤트)를 표시한 비트셋입니다.
+    const std::vector<std::uint64_t>& ConditionalMask() const { return conditionalMask_; }
+
+    // 컴파일된 조건 수와 각 조건, 조건이 속한 이벤트 위치를 반환합니다.
+    std::size_t ConditionCount() const { return conditions_.size(); }
+    const EventCondition& Condition(std::size_t slot) const { return conditions_[slot]; }
+    std::size_t ConditionEvent(std::size_t slot) const { return conditionEvents_[slot]; }
+
+    // 해당 입력(EventCondition의 의존성 번호)을 읽는 조건 번호 목록을 반환합니다.
+    const std::vector<std::uint32_t>& Dependents(std::uint32_t dependency) const;
+
+    // 조건식의 키워드와 플래그 이름 표를 반환합니다.
+    const ConditionSymbols& Symbols() const { return symbols_; }
+
+    // 이벤트가 발생할 때 켜는 플래그 번호를 반환합니다.
+    const std::vector<std::uint32_t>& FlagsSetBy(std::size_t index) const { return setFlags_[index]; }
+
+    // 이벤트 대사를 컴파일한 그래프와 이벤트의 시작 노드를 반환합니다. (대사가 없으면 DialogueGraph::kEnd)
+    const DialogueGraph& Script() const { return script_; }
+    std::uint32_t ScriptEntry(std::size_t index) const { return scriptEntries_[index]; }
+
+private:
+    std::vector<Event> events_;
+    std::unordered_map<std::string, std::size_t> index_;
+    std::size_t firstAutomatic_ = 0;
+
+    ConditionSymbols symbols_;
+    std::vector<EventCondition> conditions_;
+    std::vector<std::size_t> conditionEvents_;
+    std::unordered_map<std::uint32_t, std::vector<std::uint32_t>> dependents_;
+    std::vector<std::uint64_t> conditionalMask_;
+    std::vector<std::vector<std::uint32_t>> setFlags_;
+
+    DialogueGraph script_;
+    std::vector<std::uint32_t> scriptEntries_;
+};
+
+/**
+ * 한 플레이에서 어떤 이벤트가 발생했는지를 비트셋으로 추적합니다.
+ *
+ * 임계값 이벤트는 호감도가 닿은 위치까지를 커서로 기억해 두므로, 새로 조건을 만족한 이벤트가 없으면
+ * 매 턴 확인은 커서 비교 한 번으로 끝납니다. 조건식 이벤트는 이번 턴에 입력이 바뀐 조건만 다시 평가합니다.
+ * 발생 기록, 플래그, 말한 키워드는 캐릭터에 이름으로 남아 세이브에 저장됩니다.
+ */
+class EventProgress {
+public:
+    // 이벤트 표와 캐릭터를 연결하고, 캐릭터에 저장된 기록으로 상태를 채웁니다.
+    void Bind(const EventEngine* engine, Character& character);
+
+    // 플레이어의 입력에서 조건식이 찾는 키워드를 확인합니다.
+    void NoteSaid(const std::string& text, Character& character);
+
+    // 조건을 만족했지만 아직 발생하지 않은 이벤트의 위치를 임계값 순으로 반환합니다.
+    // 변수 값만 채워 넘기면 됩니다. (키워드와 플래그는 이 객체가 채움)
+    std::vector<std::size_t> Due(ConditionInputs inputs);
+
+    // 이벤트가 발생했음을 기록하고 이벤트가 켜는 플래그를 켭니다.
+    void MarkFired(std::size_t index, Character& character);
+
+private:
+    bool IsFired(std::size_t index) const;
+    std::size_t NextUnfired(std::size_t from) const;
+    void Reevaluate(std::uint32_t dependency, const ConditionInputs& inputs);
+    void EvaluateSlot(std::size_t slot, const ConditionInputs& inputs);
+
+    const EventEngine* engine_ = nullptr;
+    std::vector<std::uint64_t> fired_;
+    std::size_t reached_ = 0;      // [FirstAutomatic, reached_) 구간은 현재 호감도로 조건을 만족
+    std::size_t firstUnfired_ = 0;
+
+    std::vector<bool> said_;
+    std::vector<bool> flags_;
+    std::set<std::size_t> ready_;                // 조건이 참이고 아직 발생하지 않은 조건식 이벤트
+    std::vector<std::uint32_t> pendingChanges_;  // 지난 확인 이후 바뀐 키워드와 플래그
+    std::vector<std::uint32_t> evaluatedAt_;     // 조건별로 마지막으로 평가한 확인 회차 (한 번에 두 번 평가하지 않도록)
+    std::uint32_t round_ = 0;
+    int lastVariables_[ConditionInputs::VariableCount] = {};
+    bool evaluated_ = false;
+};
@@ -0,0 +1,161 @@
+#include "EventLoop.h"
+
+#include <algorithm>
+#include <deque>
+#include <iostream>
+#include <mutex>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+// 루프와 Poster들이 함께 쓰는 작업 큐와 깨우기 핸들입니다. 마지막 Poster가 사라질 때 닫힙니다.
+struct EventLoop::Poster::Mailbox {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+    bool closed = false;  // 루프가 사라졌으면 이후 작업은 버립니다.
+
+#ifdef _WIN32
+    HANDLE event = nullptr;  // 자동 리셋 이벤트
+
+    Mailbox() {
+        event = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+        if (!event) std::cerr << "[EventLoop] 깨우기 이벤트를 만들 수 없습니다.\n";
+    }
+    ~Mailbox() {
+        if (event) CloseHandle(event);
+    }
+    void Wake() {
+        if (event) SetEvent(event);
+    }
+#else
+    int readFd = -1;
+    int writeFd = -1;
+
+    Mailbox() {
+        int fds[2];
+        if (pipe(fds) != 0) {
+            std::cerr << "[EventLoop] 깨우기 파이프를 만들 수 없습니다.\n";
+            return;
+        }
+        // 파이프가 가득 차도 작업 스레드가 막히지 않고, 비울 때도 루프가 막히지 않게 합니다.
+        for (int fd : fds) {
+            fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+            fcntl(fd, F_SETFD, FD_CLOEXEC);
+        }
+        readFd = fds[0];
+        writeFd = fds[1];
+    }
+    ~Mailbox() {
+        if (readFd >= 0) close(readFd);
+        if (writeFd >= 0) close(writeFd);
+    }
+    void Wake() {
+        // 가득 차서 실패해도 읽지 않은 바이트가 남아 있으므로 루프는 깨어납니다.
+        char byte = 1;
+        if (writeFd >= 0) (void)!write(writeFd, &byte, 1);
+    }
+    void Drain() {
+        char buffer[64];
+        while (readFd >= 0 && read(readFd, buffer, sizeof(buffer)) > 0) {
+        }
+    }
+#endif
+};
+
+void EventLoop::Poster::Post(Task task) const {
+    std::lock_guard<std::mutex> lock(mailbox_->mutex);
+    if (mailbox_->closed) return;
+    // 큐가 비어 있지 않으면 이미 깨우기 신호가 가 있으므로 다시 보내지 않습니다.
+    bool wasEmpty = mailbox_->tasks.empty();
+    mailbox_->tasks.push_back(std::move(task));
+    if (wasEmpty) mailbox_->Wake();
+}
+
+EventLoop::EventLoop() : mailbox_(std::make_shared<Poster::Mailbox>()) {}
+
+EventLoop::~EventLoop() {
+    std::lock_guard<std::mutex> lock(mailbox_->mutex);
+    mailbox_->closed = true;
+    mailbox_->tasks.clear();
+}
+
+EventLoop::TimerId EventLoop::AddTimer(std::chrono::milliseconds delay, Task task, bool repeat) {
+    TimerId id = nextTimerId_++;
+    timers_.push_back(Timer{id, std::chrono::steady_clock::now() + delay,
+                            repeat ? std::max(delay, std::chrono::milliseconds(1)) : std::chrono::milliseconds(0),
+                            std::move(task)});
+    return id;
+}
+
+void EventLoop::CancelTimer(TimerId id) {
+    timers_.erase(std::remove_if(timers_.begin(), timers_.end(), [id](const Timer& timer) { return timer.id == id; }),
+                  timers_.end());
+}
+
+void EventLoop::SetInputHandler(Task onInput) {
+    onInput_ = std::move(onInput);
+}
+
+void EventLoop::RunUntil(const std::function<bool()>& done) {
+    while (!done()) {
+        if (RunPosted() || RunDueTimers()) continue;
+        Wait();
+    }
+}
+
+bool EventLoop::RunPosted() {
+    std::deque<Task> tasks;
+    {
+        std::lock_guard<std::mutex> lock(mailbox_->mutex);
+        tasks.swap(mailbox_->tasks);
+    }
+    for (Task& task : tasks) task();
+    return !tasks.empty();
+}
+
+bool EventLoop::RunDueTimers() {
+    // 한 번에 하나씩 실행합니다. 타이머 작업이 다른 타이머를 취소하거나 추가해도 안전합니다.
+    auto now = std::chrono::steady_clock::now();
+    auto due = std::find_if(timers_.begin(), timers_.end(), [now](const Timer& timer) { return timer.due <= now; });
+    if (due == timers_.end()) return false;
+
+    Task task = due->task;
+    if (due->interval.count() > 0) {
+        // 밀린 만큼 몰아서 실행하지 않고 지금부터 다시 간격을 잽니다.
+        due->due = std::max(due->due + due->interval, now);
+    } else {
+        timers_.erase(due);
+    }
+    task();
+    return true;
+}
+
+void EventLoop::Wait() {
+    int timeoutMs = -1;
+    if (!timers_.empty()) {
+        auto next = std::min_element(timers_.begin(), timers_.end(),
+                                     [](const Timer& a, const Timer& b) { return a.due < b.due; })->due;
+        auto remaining = std::chrono::ceil<std::chrono::milliseconds>(next - std::chrono::steady_clock::now());
+        timeoutMs = static_cast<int>(std::max<std::chrono::milliseconds::rep>(remaining.count(), 0));
+    }
+
+#ifdef _WIN32
+    HANDLE handles[2] = {mailbox_->event, GetStdHandle(STD_INPUT_HANDLE)};
+    DWORD count = onInput_ ? 2 : 1;
+    DWORD result = WaitForMultipleObjects(count, handles, FALSE, timeoutMs < 0 ? INFINITE : static_cast<DWORD>(timeoutMs));
+    if (result == WAIT_OBJECT_0 + 1 && onInput_) onInput_();
+#else
+    pollfd fds[2] = {{mailbox_->readFd, POLLIN, 0}, {STDIN_FILENO, POLLIN, 0}};
+    nfds_t count = onInput_ ? 2 : 1;
+    if (poll(fds, count, timeoutMs) <= 0) return;  // 시간 초과 또는 시그널(EINTR)
+    if (fds[0].revents & POLLIN) mailbox_->Drain();
+    // 입력이 닫혀도(POLLHUP) 핸들러가 읽어서 끝을 알아차리도록 넘깁니다.
+    if (count == 2 && (fds[1].revents & (POLLIN | POLLHUP | POLLERR))) onInput_();
+#endif
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+/**
+ * 게임 스레드 하나에서 키 입력, 다른 스레드가 넘긴 작업, 타이머를 차례로 처리하는 이벤트 루프입니다.
+ *
+ * POSIX에서는 poll()로 표준 입력과 깨우기용 파이프를, Windows에서는 WaitForMultipleObjects로 콘솔
+ * 입력과 이벤트 객체를 함께 기다립니다. 대기 시간은 가장 가까운 타이머까지이므로 할 일이 없으면
+ * 잠들어 있고(바쁜 대기 없음), 입력이나 작업이 도착하면 바로 깨어납니다.
+ */
+class EventLoop {
+public:
+    using Task = std::function<void()>;
+    using TimerId = std::uint64_t;
+
+    /**
+     * 다른 스레드에서 작업을 넘기는 핸들입니다. 복사해서 작업 스레드에 넘길 수 있으며,
+     * 루프가 먼저 사라지면 이후에 넘긴 작업은 실행되지 않고 버려집니다.
+     */
+    class Poster {
+    public:
+        // 작업을 게임 스레드로 넘기고 루프를 깨웁니다. (어느 스레드에서나 호출 가능)
+        void Post(Task task) const;
+
+    private:
+        friend class EventLoop;
+        struct Mailbox;
+
+        explicit Poster(std::shared_ptr<Mailbox> mailbox) : mailbox_(std::move(mailbox)) {}
+
+        std::shared_ptr<Mailbox> mailbox_;
+    };
+
+    EventLoop();
+    ~EventLoop();
+
+    EventLoop(const EventLoop&) = delete;
+    EventLoop& operator=(const EventLoop&) = delete;
+
+    Poster GetPoster() const { return Poster(mailbox_); }
+
+    // GetPoster().Post(task)와 같습니다.
+    void Post(Task task) const { GetPoster().Post(std::move(task)); }
+
+    // `delay` 뒤에 게임 스레드에서 실행할 작업을 등록합니다. `repeat`이면 같은 간격으로 반복합니다.
+    TimerId AddTimer(std::chrono::milliseconds delay, Task task, bool repeat = false);
+
+    // 등록한 타이머를 취소합니다. (이미 끝났거나 없는 id는 무시)
+    void CancelTimer(TimerId id);
+
+    // 표준 입력에 읽을 것이 생기면 호출할 함수를 설정합니다. 함수는 준비된 입력을 모두 읽어야 합니다.
+    void SetInputHandler(Task onInput);
+
+    // `done`이 true가 될 때까지 이벤트를 처리합니다. 처리한 이벤트마다 `done`을 다시 확인합니다.
+    // 작업 안에서 다시 호출해도 됩니다. (예: 작업이 키 입력을 기다림)
+    void RunUntil(const std::function<bool()>& done);
+
+private:
+    struct Timer {
+        TimerId id;
+        std::chrono::steady_clock::time_point due;
+        std::chrono::milliseconds interval;  // 0이면 한 번만 실행
+        Task task;
+    };
+
+    // 넘겨받은 작업을 모두 실행합니다. 하나라도 실행했으면 true를 반환합니다.
+    bool RunPosted();
+
+    // 시간이 된 타이머를 실행합니다. 하나라도 실행했으면 true를 반환합니다.
+    bool RunDueTimers();
+
+    // 입력, 깨우기 신호, 다음 타이머 중 먼저 오는 것을 기다립니다.
+    void Wait();
+
+    std::shared_ptr<Poster::Mailbox> mailbox_;
+    std::vector<Timer> timers_;  // 타이머는 몇 개뿐이므로 정렬 없이 훑습니다.
+    TimerId nextTimerId_ = 1;
+    Task onInput_;
+};
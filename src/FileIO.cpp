@@ -0,0 +1,253 @@
+#include "FileIO.h"
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+
+#ifdef _WIN32
+#include <io.h>
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+std::array<std::uint32_t, 256> BuildCrcTable() {
+    std::array<std::uint32_t, 256> table{};
+    for (std::uint32_t i = 0; i < 256; ++i) {
+        std::uint32_t c = i;
+        for (int k = 0; k < 8; ++k) {
+            c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        }
+        table[i] = c;
+    }
+    return table;
+}
+}  // 익명 네임스페이스 종료
+
+std::uint32_t FileIO::Crc32(std::string_view data, std::uint32_t crc) {
+    static const std::array<std::uint32_t, 256> table = BuildCrcTable();
+    crc = ~crc;
+    for (unsigned char ch : data) {
+        crc = table[(crc ^ ch) & 0xFFu] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+bool FileIO::FlushToDisk(std::FILE* file) {
+    if (std::fflush(file) != 0) return false;
+#ifdef _WIN32
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+bool FileIO::WriteAtomic(const std::string& path, std::string_view contents) {
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    if (fs::exists(path, ec)) {
+        // 기존 파일은 그대로 둔 채 `.bak`을 만들고 한 번에 바꿔 넣으므로, `path`가 사라지는 순간이 없습니다.
+        std::string backup = path + ".bak";
+        std::string backupTemp = backup + ".tmp";
+        fs::remove(backupTemp, ec);
+        fs::create_hard_link(path, backupTemp, ec);
+        if (ec) fs::copy_file(path, backupTemp, fs::copy_options::overwrite_existing, ec);
+        if (!ec) fs::rename(backupTemp, backup, ec);
+        if (ec) {
+            std::cerr << "[FileIO] 백업 생성 실패(" << path << "): " << ec.message() << '\n';
+            fs::remove(backupTemp, ec);
+        }
+    }
+    return ReplaceAtomic(path, contents);
+}
+
+bool FileIO::ReplaceAtomic(const std::string& path, std::string_view contents) {
+    namespace fs = std::filesystem;
+    std::string tempPath = path + ".tmp";
+
+    std::FILE* file = std::fopen(tempPath.c_str(), "wb");
+    if (!file) {
+        std::cerr << "[FileIO] 파일을 쓸 수 없습니다: " << tempPath << '\n';
+        return false;
+    }
+    // 내용 전체를 한 번에 쓰고 fsync는 한 번만 합니다.
+    bool ok = std::fwrite(contents.data(), 1, contents.size(), file) == contents.size();
+    ok = FlushToDisk(file) && ok;
+    ok = std::fclose(file) == 0 && ok;
+    if (!ok) {
+        std::cerr << "[FileIO] 파일 기록 실패: " << tempPath << '\n';
+        std::error_code ec;
+        fs::remove(tempPath, ec);
+        return false;
+    }
+
+    // 기존 파일 위로 바로 이름을 바꿉니다. (POSIX rename과 MOVEFILE_REPLACE_EXISTING은 대상을 원자적으로 교체)
+#ifdef _WIN32
+    std::wstring from = fs::u8path(tempPath).wstring();
+    std::wstring to = fs::u8path(path).wstring();
+    if (!MoveFileExW(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+        std::cerr << "[FileIO] 파일 교체 실패(" << path << "): 오류 " << GetLastError() << '\n';
+        std::error_code ec;
+        fs::remove(tempPath, ec);
+        return false;
+    }
+#else
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        std::cerr << "[FileIO] 파일 교체 실패(" << path << "): " << std::strerror(errno) << '\n';
+        std::error_code ec;
+        fs::remove(tempPath, ec);
+        return false;
+    }
+#endif
+    // 이름 바꾸기 자체가 디스크에 남아야 중단 뒤에도 새 내용이 보입니다.
+    std::string directory = fs::path(path).parent_path().string();
+    return SyncDirectory(directory.empty() ? "." : directory);
+}
+
+bool FileIO::SyncDirectory(const std::string& directory) {
+#ifdef _WIN32
+    // Windows는 디렉터리를 fsync할 수 없으며, MOVEFILE_WRITE_THROUGH가 이름 바꾸기를 기록합니다.
+    (void)directory;
+    return true;
+#else
+    int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+    if (fd < 0) {
+        std::cerr << "[FileIO] 디렉터리를 열 수 없습니다: " << directory << '\n';
+        return false;
+    }
+    bool ok = ::fsync(fd) == 0;
+    ::close(fd);
+    if (!ok) std::cerr << "[FileIO] 디렉터리 동기화 실패: " << directory << '\n';
+    return ok;
+#endif
+}
+
+bool FileIO::AppendDurable(const std::string& path, std::string_view contents) {
+    std::FILE* file = std::fopen(path.c_str(), "ab");
+    if (!file) {
+        std::cerr << "[FileIO] 파일을 열 수 없습니다: " << path << '\n';
+        return false;
+    }
+    bool ok = std::fwrite(contents.data(), 1, contents.size(), file) == contents.size();
+    ok = FlushToDisk(file) && ok;
+    ok = std::fclose(file) == 0 && ok;
+    if (!ok) {
+        std::cerr << "[FileIO] 파일 기록 실패: " << path << '\n';
+    }
+    return ok;
+}
+
+bool FileIO::ReadAll(const std::string& path, std::string& out) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) return false;
+
+    out.clear();
+    char buffer[64 * 1024];
+    std::size_t n;
+    while ((n = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        out.append(buffer, n);
+    }
+    bool ok = !std::ferror(file);
+    std::fclose(file);
+    return ok;
+}
+
+void FileIO::AppendChecksummedLine(std::string& out, std::string_view body) {
+    char crc[16];
+    std::snprintf(crc, sizeof(crc), "%08x ", Crc32(body));
+    out += crc;
+    out.append(body.data(), body.size());
+    out += '\n';
+}
+
+bool FileIO::ParseChecksummedLine(std::string_view line, std::string_view& body) {
+    if (line.size() < 10 || line[8] != ' ') return false;
+    std::uint32_t expected = 0;
+    for (char ch : line.substr(0, 8)) {
+        int digit = ch >= '0' && ch <= '9' ? ch - '0'
+                  : ch >= 'a' && ch <= 'f' ? ch - 'a' + 10
+                                           : -1;
+        if (digit < 0) return false;
+        expected = (expected << 4) | static_cast<std::uint32_t>(digit);
+    }
+    body = line.substr(9);
+    return Crc32(body) == expected;
+}
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+bool MappedFile::Open(const std::string& path) {
+    Close();
+#ifdef _WIN32
+    std::wstring widePath = std::filesystem::u8path(path).wstring();
+    HANDLE file = CreateFileW(widePath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file != INVALID_HANDLE_VALUE) {
+        LARGE_INTEGER size{};
+        if (GetFileSizeEx(file, &size) && size.QuadPart > 0) {
+            HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping) {
+                void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                if (view) {
+                    mapping_ = mapping;
+                    data_ = static_cast<const char*>(view);
+                    size_ = static_cast<std::size_t>(size.QuadPart);
+                    mapped_ = true;
+                } else {
+                    CloseHandle(mapping);
+                }
+            }
+        }
+        CloseHandle(file);
+    }
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        struct stat info {};
+        if (::fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+            void* view = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (view != MAP_FAILED) {
+                ::madvise(view, static_cast<std::size_t>(info.st_size), MADV_SEQUENTIAL);
+                data_ = static_cast<const char*>(view);
+                size_ = static_cast<std::size_t>(info.st_size);
+                mapped_ = true;
+            }
+        }
+        ::close(fd);  // 매핑은 파일 설명자를 닫아도 유지됩니다.
+    }
+#endif
+    if (mapped_) return true;
+
+    // 매핑할 수 없으면 버퍼로 읽습니다.
+    if (!FileIO::ReadAll(path, buffer_)) return false;
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+    return true;
+}
+
+void MappedFile::Close() {
+    if (mapped_) {
+#ifdef _WIN32
+        UnmapViewOfFile(data_);
+        CloseHandle(mapping_);
+        mapping_ = nullptr;
+#else
+        ::munmap(const_cast<char*>(data_), size_);
+#endif
+    }
+    buffer_.clear();
+    data_ = nullptr;
+    size_ = 0;
+    mapped_ = false;
+}
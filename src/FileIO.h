@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+/**
+ * 저장 파일을 안전하게 쓰고 읽기 위한 저수준 파일 헬퍼입니다.
+ */
+class FileIO {
+public:
+    // CRC-32(IEEE 802.3) 체크섬을 계산합니다. `crc`에 이전 결과를 넘기면 이어서 계산합니다.
+    static std::uint32_t Crc32(std::string_view data, std::uint32_t crc = 0);
+
+    // 스트림 버퍼를 비우고 파일 내용을 디스크까지 기록(fsync)합니다.
+    static bool FlushToDisk(std::FILE* file);
+
+    // ReplaceAtomic과 같되, 교체하기 전에 기존 파일을 `<path>.bak`으로 남겨 직전 세대로 복구할 수 있게 합니다.
+    // (하드 링크로 만들고, 링크할 수 없으면 복사합니다)
+    static bool WriteAtomic(const std::string& path, std::string_view contents);
+
+    // 임시 파일에 한 번에 쓰고 fsync한 뒤 기존 파일 위로 이름을 바꿔 원자적으로 교체하고, 디렉터리까지 fsync합니다.
+    // 어느 순간에 중단되더라도 `path`는 이전 내용이나 새 내용 중 하나로 온전히 존재합니다.
+    static bool ReplaceAtomic(const std::string& path, std::string_view contents);
+
+    // 디렉터리 항목의 변경(생성, 이름 바꾸기)을 디스크까지 기록합니다. (Windows에서는 할 일이 없음)
+    static bool SyncDirectory(const std::string& directory);
+
+    // 파일 끝에 내용을 한 번에 덧붙이고 fsync합니다.
+    static bool AppendDurable(const std::string& path, std::string_view contents);
+
+    // 파일 전체를 읽어 `out`에 저장합니다.
+    static bool ReadAll(const std::string& path, std::string& out);
+
+    // 추가 전용 로그 한 줄("<crc32 8자리> <본문>\n")을 `out`에 덧붙입니다.
+    static void AppendChecksummedLine(std::string& out, std::string_view body);
+
+    // 체크섬 줄을 검증하고 본문을 `body`로 돌려줍니다. 잘렸거나 손상된 줄이면 false를 반환합니다.
+    static bool ParseChecksummedLine(std::string_view line, std::string_view& body);
+};
+
+/**
+ * 읽기 전용 파일 뷰입니다. 가능하면 메모리 매핑(mmap / MapViewOfFile)을 사용하고,
+ * 매핑할 수 없는 경우(빈 파일, 특수 파일 등)에는 버퍼로 읽어들입니다.
+ * View()는 파일 내용을 복사 없이 가리키므로 JSON 파서의 반복자 입력으로 바로 넘길 수 있습니다.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // 파일을 엽니다. 이미 열린 파일은 먼저 닫습니다.
+    bool Open(const std::string& path);
+
+    // 매핑을 해제하고 버퍼를 비웁니다.
+    void Close();
+
+    // 파일 내용을 반환합니다. (Close 또는 소멸 전까지 유효)
+    std::string_view View() const { return {data_, size_}; }
+
+    // 메모리 매핑으로 열렸는지 반환합니다.
+    bool IsMapped() const { return mapped_; }
+
+private:
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+    bool mapped_ = false;
+    std::string buffer_;  // 매핑하지 못했을 때의 대체 버퍼
+#ifdef _WIN32
+    void* mapping_ = nullptr;
+#endif
+};
@@ -1,22 +1,60 @@
 #include "Game.h"
 
 #include <algorithm>
-#include <array>
 #include <cctype>
 #include <thread>
 #include <chrono>
+#include <ctime>
 #include <vector>
 
+#include "AssetBundle.h"
 #include "Character.h"
 #include "Config.h"
 #include "DialogueManager.h"
-#include "JsonHelper.h"
 #include "LLMClient.h"
 #include "SaveSystem.h"
 #include "TUI.h"
 
 namespace {
-constexpr std::array<int, 5> kStageThresholds{0, 25, 50, 75, 100};
+// 로드 메뉴 한 페이지에 표시할 세이브 수
+constexpr std::size_t kLoadMenuPageSize = 10;
+
+// 캐릭터 id가 기록되지 않은 이전 세이브가 사용하던 캐릭터
+const char* const kLegacyCharacterId = "template_character";
+
+// 단계 프롬프트가 없을 때 넘기는 빈 지침 (캐릭터의 단계 정보로 대체됨)
+const std::string kNoStagePrompt;
+
+// 이벤트 대사의 {player}, {char}를 이름으로 바꿉니다.
+std::string ExpandNames(std::string_view text, const std::string& playerName, const std::string& characterName) {
+    std::string out;
+    out.reserve(text.size());
+    while (!text.empty()) {
+        if (text.substr(0, 8) == "{player}") {
+            out += playerName;
+            text.remove_prefix(8);
+        } else if (text.substr(0, 6) == "{char}") {
+            out += characterName;
+            text.remove_prefix(6);
+        } else {
+            out += text.front();
+            text.remove_prefix(1);
+        }
+    }
+    return out;
+}
+
+// 이벤트 조건식의 hour 변수에 쓰는 현재 시각(0~23)
+int CurrentHour() {
+    std::time_t now = std::time(nullptr);
+    std::tm local{};
+#ifdef _WIN32
+    localtime_s(&local, &now);
+#else
+    localtime_r(&now, &local);
+#endif
+    return local.tm_hour;
+}
 }  // 익명 네임스페이스 종료
 
 Game::Game(Config& config,
@@ -29,8 +67,14 @@ Game::Game(Config& config,
       dialogueManager_(dialogueManager),
       llmClient_(llmClient),
       saveSystem_(saveSystem),
-      activeCharacter_(nullptr),
-      isRunning_(false) {}
+      saveWorker_(saveSystem),
+      roster_(config),
+      isRunning_(false) {
+    // 저장이 끝나면 작업자 스레드가 게임 스레드를 깨워, 입력을 기다리는 중에도 결과를 바로 보여줍니다.
+    saveWorker_.SetOnComplete([this, poster = ui_.Events().GetPoster()]() {
+        poster.Post([this]() { ReportSaveResults(); });
+    });
+}
 
 void Game::Run() {
     // 초기 API 키 검증 루프
@@ -38,6 +82,7 @@ void Game::Run() {
     while (!isKeyValid) {
         if (config_.GetApiKey().empty()) {
             std::string key = ui_.ShowApiKeyPrompt();
+            if (ui_.QuitRequested()) return;
             if (!key.empty()) {
                 config_.SetApiKey(key);
                 llmClient_.SetApiKey(key);
@@ -64,7 +109,14 @@ void Game::Run() {
     
     ui_.ClearScreen();
 
-    while (true) {
+    // 캐릭터 파일 이름만 색인합니다. 캐릭터 에셋은 선택될 때 읽습니다.
+    roster_.Scan();
+    for (const auto& directory : roster_.WatchDirectories()) {
+        contentWatcher_.Watch(directory);
+    }
+
+    while (!ui_.QuitRequested()) {
+        ApplyContentUpdates();
         TUI::MenuOption option = ui_.ShowMainMenu();
         
         if (option == TUI::MenuOption::Exit) {
@@ -72,19 +124,18 @@ void Game::Run() {
         }
 
         if (option == TUI::MenuOption::NewGame) {
-            characters_.clear();
-            
-            nlohmann::json charData;
+            std::string characterId = PromptCharacterSelection();
+            if (ui_.QuitRequested()) break;
+            if (characterId.empty() && !roster_.Ids().empty()) continue; // 선택 취소
+
+            characters_.Clear();
+            ActivateAssets(characterId);
+
             Character newChar("New Character");
-            if (JsonHelper::LoadFromFile("data/characters/template_character.json", charData)) {
-                newChar = charData.get<Character>(); // 누락된 키는 JSON 변환 과정에서 기본값으로 처리됨
-                
-                // 꼭 필요하면 기본값으로 덮어쓸 수 있지만 Character.cpp의 from_json이 이미 처리함
-                if (charData.contains("initialAffection") && !charData.contains("affection")) {
-                     // from_json에서 처리
-                }
+            if (activeAssets_) {
+                newChar = activeAssets_->persona;
             } else {
-                ui_.PrintSystem("경고: 캐릭터 템플릿(data/characters/template_character.json)을 찾을 수 없습니다.");
+                ui_.PrintSystem("경고: 캐릭터 파일(" + config_.GetCharactersDir() + ")을 찾을 수 없습니다.");
                 ui_.PrintSystem("기본값(샘플 캐릭터)으로 시작합니다.");
                 
                 newChar.SetName("샘플 캐릭터");
@@ -93,32 +144,38 @@ void Game::Run() {
                 newChar.SetRelationshipStage(0);
             }
 
-            characters_.push_back(newChar);
-            activeCharacter_ = &characters_.front();
+            activeCharacter_ = characters_.Insert(std::move(newChar));
+            Character* active = ActiveCharacter();
+            BindEvents();
             
             dialogueManager_.GetContext().Clear();
-            LoadEvents(config_.GetEventsFile());
-
+            saveWorker_.WaitIdle();
+            saveSystem_.BeginPlaythrough();
 
+            lastReply_.reset();
+            RefreshStatus();  // 설정 화면부터 상태 표시줄이 보입니다.
             ui_.ShowIntro();
             
             auto [pName, cName] = ui_.ShowSetupScreen();
+            if (ui_.QuitRequested()) break;
             playerName_ = pName;
             
             if (!cName.empty()) {
-                activeCharacter_->SetName(cName);
+                active->SetName(cName);
             }
             
-            ui_.ShowChatScreen(activeCharacter_->GetName());
-            ui_.PrintSystem(activeCharacter_->GetName() + "과(와) 이야기를 시작합니다.");
+            ui_.ShowChatScreen(active->GetName());
+            ui_.PrintSystem(active->GetName() + "과(와) 이야기를 시작합니다.");
             
             RunGameLoop();
         } else if (option == TUI::MenuOption::LoadGame) {
             PromptLoadSelection();
-            if (activeCharacter_) {
+            if (ui_.QuitRequested()) break;
+            if (Character* active = ActiveCharacter()) {
                 if (playerName_.empty()) playerName_ = "당신"; 
-                ui_.ShowChatScreen(activeCharacter_->GetName());
-                LoadEvents(config_.GetEventsFile());
+                lastReply_.reset();
+                RefreshStatus();
+                ui_.ShowChatScreen(active->GetName());
                 RunGameLoop();
             }
         }
@@ -128,8 +185,24 @@ void Game::Run() {
 
 void Game::RunGameLoop() {
     isRunning_ = true;
+    savedTurns_ = dialogueManager_.GetContext().Size();
+    autosaveDue_ = false;
+    if (config_.GetAutosaveIntervalSeconds() > 0) {
+        autosaveTimer_ = ui_.Events().AddTimer(std::chrono::seconds(config_.GetAutosaveIntervalSeconds()),
+                                               [this]() { Autosave(); }, true);
+    }
+
     while (isRunning_) {
+        ReportSaveResults();
+        ApplyContentUpdates();
+
+        // 지난 턴의 호감도 변화와 이벤트 결과를 반영합니다. (바뀐 칸만 다시 그림)
+        RefreshStatus();
+        awaitingInput_ = true;
+        if (autosaveDue_) Autosave();
         std::string input = ui_.GetPlayerInput(playerName_);
+        awaitingInput_ = false;
+        if (ui_.QuitRequested()) break;  // Ctrl+C: 메뉴를 거치지 않고 Run까지 빠져나갑니다.
         if (input.empty()) continue;
 
         if (input.front() == '/') {
@@ -140,40 +213,92 @@ void Game::RunGameLoop() {
         }
         ProcessTurn(input);
     }
+    if (autosaveTimer_ != 0) {
+        ui_.Events().CancelTimer(autosaveTimer_);
+        autosaveTimer_ = 0;
+    }
+    // 메뉴로 돌아가기 전에 남은 저장을 마칩니다.
+    saveWorker_.WaitIdle();
+    ReportSaveResults();
 }
 
 void Game::ProcessTurn(const std::string& userInput) {
-    if (!activeCharacter_) return;
+    Character* character = ActiveCharacter();
+    if (!character) return;
 
     DialogueContext& context = dialogueManager_.GetContext();
-    context.AddTurn(playerName_, userInput);
+    int affectionDelta = dialogueManager_.ScoreAffectionDelta(userInput);
+    context.AddTurn(TurnRole::Player, playerName_, userInput, affectionDelta);
+    eventProgress_.NoteSaid(userInput, *character);
 
     // 채팅 메시지 생성 (DialogueManager에게 위임)
-    nlohmann::json messages = dialogueManager_.BuildFullPrompt(activeCharacter_, playerName_);
-
-    // LLM으로부터 응답 수신 (UI 출력 없음)
-    std::string npcReply = dialogueManager_.FetchNpcResponse(llmClient_, messages);
-
-    // TUI를 통해 출력 (Game 클래스가 직접 UI 제어)
-    ui_.PrintNpcTyped(activeCharacter_->GetName(), npcReply);
-
-    context.AddTurn(activeCharacter_->GetName(), npcReply);
+    const std::string& stagePrompt =
+        activeAssets_ ? activeAssets_->StagePrompt(character->GetRelationshipStage()) : kNoStagePrompt;
+    nlohmann::json messages = dialogueManager_.BuildFullPrompt(character, playerName_, stagePrompt);
+
+    // 응답은 받는 대로 TUI를 통해 출력됩니다. (Game 클래스가 직접 UI 제어)
+    std::string npcReply = AwaitNpcResponse(messages, *character, true);
+    if (!npcReply.empty()) {
+        context.AddTurn(TurnRole::Npc, character->GetName(), npcReply);
+    }
 
-    int affectionDelta = dialogueManager_.ScoreAffectionDelta(userInput);
     if (affectionDelta != 0) {
-        activeCharacter_->AddAffection(affectionDelta);
-        AutoAdvanceRelationship(*activeCharacter_);
+        character->AddAffection(affectionDelta);
+        AutoAdvanceRelationship(*character);
     }
     
     if (affectionDelta > 0) {
-        ui_.PrintSystem("호감도 상승! (현재 호감도:" + std::to_string(activeCharacter_->GetAffection()) + ")");
+        ui_.PrintSystem("호감도 상승! (현재 호감도:" + std::to_string(character->GetAffection()) + ")");
     } else if (affectionDelta < 0) {
-        ui_.PrintSystem("호감도 하락... (현재 호감도:" + std::to_string(activeCharacter_->GetAffection()) + ")");
+        ui_.PrintSystem("호감도 하락... (현재 호감도:" + std::to_string(character->GetAffection()) + ")");
     }
 
     CheckAndTriggerEvents();
 }
 
+std::string Game::AwaitNpcResponse(const nlohmann::json& messages, const Character& character, bool stream) {
+    std::function<void(const std::string&)> onToken;
+    auto streamed = std::make_shared<std::string>();  // 화면에 낸 본문
+    if (stream) {
+        ui_.BeginNpcStream(character.GetName());
+        onToken = [this, streamed](const std::string& token) {
+            *streamed += token;
+            ui_.AppendNpcStream(token);
+            RefreshStatus();
+        };
+    }
+    std::shared_ptr<NpcReply> reply = dialogueManager_.FetchNpcResponseAsync(
+        llmClient_, messages, character, ui_.Events().GetPoster(), std::move(onToken));
+    lastReply_ = reply;
+    RefreshStatus();
+
+    // 기다리는 동안에도 키 입력, 저장 완료, 자동 저장 타이머를 처리합니다.
+    bool finished = ui_.WaitForReply([&reply]() { return reply->Done(); });
+    RefreshStatus();
+    if (!finished) {
+        reply->Cancel();
+        if (stream) ui_.EndNpcStream();
+        ui_.PrintSystem("(응답을 취소했습니다)");
+        return reply->Text();  // 받은 데까지만 대화에 남깁니다.
+    }
+
+    if (stream) {
+        // 후보 모드나 오류 응답은 조각 없이 최종 응답만 오므로, 아직 출력하지 않은 부분을 이어서 출력합니다.
+        const std::string& text = reply->Text();
+        if (text.compare(0, streamed->size(), *streamed) == 0) {
+            if (text.size() > streamed->size()) ui_.AppendNpcStream(std::string_view(text).substr(streamed->size()));
+            ui_.EndNpcStream();
+            return text;
+        }
+        // 조각을 받던 중에 실패하면 최종 응답이 오류 메시지로 바뀝니다.
+        // 화면에 낸 본문만 대화에 남기고 오류는 따로 알립니다.
+        ui_.EndNpcStream();
+        ui_.PrintSystem("(응답이 중간에 끊겼습니다: " + text + ")");
+        return *streamed;
+    }
+    return reply->Text();
+}
+
 bool Game::HandleMetaCommand(const std::string& cmd) {
     std::string lowered = cmd;
     std::transform(lowered.begin(), lowered.end(), lowered.begin(),
@@ -191,18 +316,70 @@ bool Game::HandleMetaCommand(const std::string& cmd) {
         isRunning_ = false;
         return true;
     }
+    if (lowered == "export") {
+        Character* character = ActiveCharacter();
+        if (!character) return true;
+        saveWorker_.WaitIdle();
+        std::string fname = saveSystem_.ExportJson(*character, dialogueManager_.GetContext(), playerName_);
+        ui_.PrintSystem(fname.empty() ? "내보내기 실패" : "JSON 내보내기 완료: " + fname);
+        return true;
+    }
     if (lowered == "help") {
-        ui_.PrintSystem("/save, /quit, /restart");
+        ui_.PrintSystem("/save, /export, /quit, /restart, /search <키워드>, /history");
+        return true;
+    }
+    if (lowered == "history") {
+        ui_.BrowseHistory(dialogueManager_.GetContext().Size(),
+                          [this](std::size_t begin, std::size_t end, std::vector<TUI::HistoryEntry>& out) {
+                              CollectHistory(begin, end, out);
+                          });
+        return true;
+    }
+    if (lowered.rfind("search ", 0) == 0) {
+        // 키워드 자체는 대소문자를 유지한 원문에서 가져옵니다.
+        std::string keyword = cmd.substr(7);
+        const DialogueContext& context = dialogueManager_.GetContext();
+        auto hits = context.Search(keyword, 5);
+        if (hits.empty()) {
+            ui_.PrintSystem("검색 결과가 없습니다: " + keyword);
+            return true;
+        }
+        for (std::size_t index : hits) {
+            context.ForEachTurn(index, index + 1, [&](const TurnView& turn) {
+                ui_.PrintSystem("#" + std::to_string(index + 1) + " [" + std::string(turn.speaker) + "] " +
+                                std::string(turn.text));
+                return true;
+            });
+        }
         return true;
     }
     return false;
 }
 
 void Game::SaveProgress() {
-    if (!activeCharacter_) return;
-    std::string fname = saveSystem_.SaveNew(*activeCharacter_, dialogueManager_.GetContext());
-    if (!fname.empty()) ui_.PrintSystem("저장 완료: " + fname);
-    else ui_.PrintSystem("저장 실패");
+    Character* character = ActiveCharacter();
+    if (!character) return;
+    // 스냅샷만 넘기고 바로 돌아옵니다. 결과는 저장이 끝나는 대로 표시됩니다.
+    saveWorker_.Submit(*character, dialogueManager_.GetContext(), playerName_);
+    savedTurns_ = dialogueManager_.GetContext().Size();
+}
+
+void Game::Autosave() {
+    // 턴 처리나 이벤트 도중에는 상태가 반쯤 바뀌어 있으므로 입력을 기다리는 동안에만 저장합니다.
+    if (!awaitingInput_) {
+        autosaveDue_ = true;
+        return;
+    }
+    autosaveDue_ = false;
+    if (dialogueManager_.GetContext().Size() == savedTurns_) return;  // 지난 저장 이후 새 대화 없음
+    SaveProgress();
+}
+
+void Game::ReportSaveResults() {
+    for (const SaveResult& result : saveWorker_.PollCompleted()) {
+        if (result.ok) ui_.PrintSystem("저장 완료: " + result.filename);
+        else ui_.PrintSystem("저장 실패");
+    }
 }
 
 void Game::LoadProgress() {
@@ -210,117 +387,305 @@ void Game::LoadProgress() {
 }
 
 void Game::AutoAdvanceRelationship(Character& character) {
+    // 미리 계산된 표에서 바로 찾으므로 여러 단계를 한 번에 오르내릴 수 있습니다.
+    const StageTable& stages = activeAssets_ ? activeAssets_->stages : StageTable::Default();
     int currentStage = character.GetRelationshipStage();
-    if (currentStage >= static_cast<int>(kStageThresholds.size()) - 1) return;
-
-    // 참고: 현재 임계값은 kStageThresholds(0, 25, 50, 75, 100)에 하드코딩 되어 있습니다.
-    int nextStage = currentStage + 1;
-    if (character.GetAffection() >= kStageThresholds[nextStage]) {
-        character.AdvanceRelationshipStage();
-        ui_.PrintSystem("관계 단계 상승! (" + std::to_string(nextStage) + ")");
+    int targetStage = stages.StageOf(character.GetAffection());
+    if (targetStage == currentStage) return;
+
+    character.SetRelationshipStage(targetStage);
+    if (targetStage > currentStage) {
+        ui_.PrintSystem("관계 단계 상승! (" + std::to_string(targetStage) + ")");
+    } else {
+        ui_.PrintSystem("관계 단계 하락... (" + std::to_string(targetStage) + ")");
     }
 }
 
-void Game::PromptLoadSelection() {
-    auto files = saveSystem_.ListSaveFiles();
-    if (files.empty()) {
-        ui_.PrintSystem("저장 파일이 없습니다.");
-        ui_.WaitForKey();
-        return;
+void Game::RefreshStatus() {
+    TUI::ChatStatus status;
+    status.provider = llmClient_.GetProvider() == LLMProvider::OpenAI ? "openai" : "ollama";
+    status.model = llmClient_.GetModel();
+    if (lastReply_) {
+        status.timeToFirstToken = lastReply_->TimeToFirstToken();
+        status.tokensPerSecond = lastReply_->TokensPerSecond();
+        const LLMUsage& usage = lastReply_->Usage();
+        status.promptTokens = usage.promptTokens;
+        status.completionTokens = usage.completionTokens;
+        status.cachedTokens = usage.cachedTokens;
     }
-    
-    ui_.ClearScreen();
-    ui_.PrintSystem("불러올 파일을 선택하세요 (번호 입력):");
-    for (size_t i = 0; i < files.size(); ++i) {
-        ui_.PrintSystem(std::to_string(i + 1) + ". " + files[i]);
+    if (Character* character = ActiveCharacter()) {
+        int stage = character->GetRelationshipStage();
+        status.affection = character->GetAffection();
+        status.stage = std::to_string(stage) + "단계 " + character->GetStageInfo(stage).name;
     }
-    
-    std::string input = ui_.ReadInput("선택> ");
-    try {
-        int idx = std::stoi(input);
-        if (idx >= 1 && idx <= (int)files.size()) {
-            characters_.clear();
+    ui_.UpdateStatus(status);
+}
+
+void Game::PromptLoadSelection() {
+    saveWorker_.WaitIdle();
+
+    // 색인에서 한 페이지 분량만 꺼내 표시합니다.
+    std::size_t offset = 0;
+    while (true) {
+        // 없어진 파일을 고르면 색인에서 빠지므로 매번 다시 셉니다.
+        std::size_t total = saveSystem_.SaveCount();
+        if (total == 0) {
+            ui_.PrintSystem("저장 파일이 없습니다.");
+            ui_.WaitForKey();
+            return;
+        }
+        offset = std::min(offset, (total - 1) / kLoadMenuPageSize * kLoadMenuPageSize);
+        auto entries = saveSystem_.ListSaves(offset, kLoadMenuPageSize);
+        ui_.ClearScreen();
+        ui_.PrintSystem("불러올 파일을 선택하세요 (번호 입력, n: 다음, p: 이전, 빈 입력: 취소) [" +
+                        std::to_string(offset + 1) + "-" + std::to_string(offset + entries.size()) +
+                        " / " + std::to_string(total) + "]");
+        for (std::size_t i = 0; i < entries.size(); ++i) {
+            const SaveCatalogEntry& entry = entries[i];
+            ui_.PrintSystem(std::to_string(offset + i + 1) + ". " + entry.character +
+                            " | 호감도 " + std::to_string(entry.affection) +
+                            " | 단계 " + std::to_string(entry.stage) +
+                            " | 대화 " + std::to_string(entry.turns) + "턴 | " + entry.file);
+        }
+
+        std::string input = ui_.ReadInput("선택> ");
+        if (input.empty()) return;
+        if (input == "n" || input == "N") {
+            if (offset + kLoadMenuPageSize < total) offset += kLoadMenuPageSize;
+            continue;
+        }
+        if (input == "p" || input == "P") {
+            offset = offset >= kLoadMenuPageSize ? offset - kLoadMenuPageSize : 0;
+            continue;
+        }
+
+        try {
+            int idx = std::stoi(input);
+            if (idx < 1 || idx > static_cast<int>(total)) continue;
+            auto selected = saveSystem_.ListSaves(static_cast<std::size_t>(idx - 1), 1);
+            if (selected.empty()) continue;
+
+            // 로드 도중 대화 기록이 바뀔 수 있으므로 기존 캐릭터를 먼저 비웁니다.
+            // 실패하면 남은 핸들이 무효가 되어 이전 게임으로 돌아가지 않습니다.
+            characters_.Clear();
             Character loaded("Temp");
-            if (saveSystem_.LoadFromFile(files[idx - 1], loaded, dialogueManager_.GetContext())) {
-                characters_.push_back(loaded);
-                activeCharacter_ = &characters_.front();
+            if (saveSystem_.LoadFromFile(selected.front().file, loaded, dialogueManager_.GetContext(), playerName_)) {
+                std::string characterId = loaded.GetId().empty() ? kLegacyCharacterId : loaded.GetId();
+                activeCharacter_ = characters_.Insert(std::move(loaded));
+                ActivateAssets(characterId);
+                BindEvents();
                 ui_.PrintSystem("로드 성공! Enter를 눌러 게임을 시작하세요!");
                 ui_.WaitForKey();
+            } else if (saveSystem_.SaveCount() < total) {
+                ui_.PrintSystem("저장 파일이 없어 목록에서 지웠습니다.");
+                ui_.WaitForKey();
             } else {
                 ui_.PrintSystem("로드 실패.");
                 ui_.WaitForKey();
             }
+        } catch (...) {
+            ui_.PrintSystem("잘못된 입력입니다.");
+            ui_.WaitForKey();
         }
-    } catch (...) {
-        ui_.PrintSystem("잘못된 입력입니다.");
-        ui_.WaitForKey();
+        return;
     }
 }
 
-void Game::LoadEvents(const std::string& filePath) {
-    nlohmann::json doc;
-    if (!JsonHelper::LoadFromFile(filePath, doc)) {
-        return;
+std::string Game::PromptCharacterSelection() {
+    const std::vector<std::string>& ids = roster_.Ids();
+    if (ids.size() <= 1) return ids.empty() ? std::string() : ids.front();
+
+    // 이름을 보여주려면 캐릭터 파일을 열어야 하므로 id만 표시합니다.
+    std::size_t offset = 0;
+    while (true) {
+        std::size_t end = std::min(ids.size(), offset + kLoadMenuPageSize);
+        ui_.ClearScreen();
+        ui_.PrintSystem("대화할 캐릭터를 선택하세요 (번호 입력, n: 다음, p: 이전, 빈 입력: 취소) [" +
+                        std::to_string(offset + 1) + "-" + std::to_string(end) +
+                        " / " + std::to_string(ids.size()) + "]");
+        for (std::size_t i = offset; i < end; ++i) {
+            ui_.PrintSystem(std::to_string(i + 1) + ". " + ids[i]);
+        }
+
+        std::string input = ui_.ReadInput("선택> ");
+        if (input.empty()) return {};
+        if (input == "n" || input == "N") {
+            if (offset + kLoadMenuPageSize < ids.size()) offset += kLoadMenuPageSize;
+            continue;
+        }
+        if (input == "p" || input == "P") {
+            offset = offset >= kLoadMenuPageSize ? offset - kLoadMenuPageSize : 0;
+            continue;
+        }
+        try {
+            int idx = std::stoi(input);
+            if (idx >= 1 && idx <= static_cast<int>(ids.size())) return ids[static_cast<std::size_t>(idx - 1)];
+        } catch (...) {
+            // 숫자가 아니면 다시 묻습니다.
+        }
+    }
+}
+
+void Game::ActivateAssets(const std::string& characterId) {
+    // 이전 캐릭터의 에셋을 놓아주어야 로스터가 필요할 때 내보낼 수 있습니다.
+    activeAssets_.reset();
+    activeCharacterId_ = characterId;
+    if (!characterId.empty()) {
+        activeAssets_ = roster_.Acquire(characterId);
     }
-    if (!doc.is_array()) {
-        std::cerr << "Error: Events file root is not an array." << std::endl;
+}
+
+Character* Game::ActiveCharacter() {
+    return characters_.Get(activeCharacter_);
+}
+
+void Game::ApplyContentUpdates() {
+    std::vector<std::string> changed = contentWatcher_.Poll();
+    if (changed.empty()) return;
+
+    std::vector<std::string> reloaded = roster_.OnContentChanged(changed);
+    // 새로 생긴 캐릭터 디렉토리도 감시합니다. (이미 감시 중이면 무시됨)
+    for (const auto& directory : roster_.WatchDirectories()) {
+        contentWatcher_.Watch(directory);
+    }
+    if (activeCharacterId_.empty() ||
+        std::find(reloaded.begin(), reloaded.end(), activeCharacterId_) == reloaded.end()) {
         return;
     }
 
-    try {
-        events_ = doc.get<std::vector<Event>>();
-    } catch (const nlohmann::json::exception& e) {
-        std::cerr << "JSON Parsing Error: " << e.what() << std::endl;
-        std::cerr << "Dump: " << doc.dump(4) << std::endl;
+    // 새 에셋을 만든 뒤 포인터만 바꿔 끼웁니다. 이전 에셋은 마지막 참조가 사라질 때 해제됩니다.
+    std::shared_ptr<const CharacterAssets> fresh = roster_.Acquire(activeCharacterId_);
+    if (!fresh) {
+        ui_.PrintSystem("[시스템] 바뀐 캐릭터 파일을 읽을 수 없어 이전 내용을 계속 사용합니다.");
+        return;
     }
+    activeAssets_ = std::move(fresh);
+    // 성격 설정은 콘텐츠이므로 진행 중인 캐릭터에도 반영합니다. (이름, 호감도 등 진행 상태는 유지)
+    if (Character* character = ActiveCharacter()) {
+        character->SetTraits(activeAssets_->persona.GetTraits());
+    }
+    BindEvents();
+    ui_.PrintSystem("[시스템] 콘텐츠가 갱신되었습니다: " + activeCharacterId_);
+}
+
+void Game::BindEvents() {
+    Character* character = ActiveCharacter();
+    if (!character) return;
+    eventProgress_.Bind(activeAssets_ ? activeAssets_->events.get() : nullptr, *character);
 }
 
 void Game::CheckAndTriggerEvents() {
-    if (!activeCharacter_) return;
+    Character* character = ActiveCharacter();
+    if (!character || !activeAssets_) return;
     
+    ConditionInputs inputs;
+    inputs.variables[ConditionInputs::Affection] = character->GetAffection();
+    inputs.variables[ConditionInputs::Stage] = character->GetRelationshipStage();
+    inputs.variables[ConditionInputs::Turns] = static_cast<int>(dialogueManager_.GetContext().Size() / 2);
+    inputs.variables[ConditionInputs::Hour] = CurrentHour();
+
     bool triggered = false;
-    int currentAffection = activeCharacter_->GetAffection();
-    
-    for (const auto& event : events_) {
-        // 조건:
-        // 1. 호감도 >= 임계값
-        // 2. 아직 발생하지 않은 이벤트
-        if (event.threshold > 0 && 
-            currentAffection >= event.threshold && 
-            !activeCharacter_->HasTriggeredEvent(event.threshold)) {
+    // 조건(임계값과 조건식, 아직 발생하지 않음)을 만족하는 이벤트만 임계값 순으로 받아옵니다.
+    for (std::size_t index : eventProgress_.Due(inputs)) {
+        const Event& event = activeAssets_->events->At(index);
+        ui_.PrintSystem(">>> 이벤트 발생 조건 달성: [" + event.title + "]");
+        std::string ans = ui_.ReadInput("이벤트를 보시겠습니까? (y/n)> ");
+        if (ui_.QuitRequested()) return;
+        if (!ans.empty() && (ans[0] == 'y' || ans[0] == 'Y')) {
+            // 이벤트 전 자동 저장
+            ui_.PrintSystem("[시스템] 이벤트 진입 전 자동 저장을 수행합니다...");
+            SaveProgress();
             
-            ui_.PrintSystem(">>> 이벤트 발생 조건 달성: [" + event.title + "]");
-            std::string ans = ui_.ReadInput("이벤트를 보시겠습니까? (y/n)> ");
-            if (!ans.empty() && (ans[0] == 'y' || ans[0] == 'Y')) {
-                // 이벤트 전 자동 저장
-                ui_.PrintSystem("[시스템] 이벤트 진입 전 자동 저장을 수행합니다...");
-                SaveProgress();
-                
-                PlayEvent(event);
-                activeCharacter_->MarkEventTriggered(event.threshold);
-                triggered = true;
-            }
+            PlayEvent(index, *character);
+            eventProgress_.MarkFired(index, *character);
+            triggered = true;
         }
     }
     
     if (triggered) {
         ui_.ClearScreen();
-        ui_.ShowChatScreen(activeCharacter_->GetName());
+        ui_.ShowChatScreen(character->GetName());
         RestoreChatHistory(); // 채팅 내역 복구
     }
 }
 
-void Game::PlayEvent(const Event& event) {
-    ui_.ShowEvent(event.title, event.lines);
+void Game::PlayEvent(std::size_t index, Character& character) {
+    const EventEngine& events = *activeAssets_->events;
+    const DialogueGraph& script = events.Script();
+    auto text = [&](std::uint32_t id) { return ExpandNames(script.Text(id), playerName_, character.GetName()); };
+
+    ui_.BeginEvent(events.At(index).title);
+    int affectionBefore = character.GetAffection();
+    // 컴파일된 그래프를 노드 번호로 따라갑니다. (검증 단계에서 순환이 없음을 확인함)
+    // 도중에 Ctrl+C를 누르면 남은 노드를 건너뜁니다.
+    for (std::uint32_t node = events.ScriptEntry(index); node != DialogueGraph::kEnd && !ui_.QuitRequested();) {
+        const DialogueGraph::Node& current = script.At(node);
+        character.AddAffection(current.affection);
+        switch (current.kind) {
+            case DialogueGraph::NodeKind::Line:
+                ui_.ShowEventLine(text(current.speaker), text(current.text));
+                node = current.next;
+                break;
+            case DialogueGraph::NodeKind::Generate: {
+                const std::string& stagePrompt = activeAssets_->StagePrompt(character.GetRelationshipStage());
+                nlohmann::json messages =
+                    dialogueManager_.BuildEventLinePrompt(&character, playerName_, stagePrompt, text(current.text));
+                std::string line = AwaitNpcResponse(messages, character, false);
+                if (line.empty() || line.rfind("Error:", 0) == 0) {
+                    // 실패하면 오류를 대사로 내보내지 않고, 연출 지시문을 해설로 대신 보여 줍니다.
+                    if (!line.empty()) ui_.PrintSystem("(대사를 만들지 못했습니다: " + line + ")");
+                    ui_.ShowEventLine("", text(current.text));
+                } else {
+                    std::string speaker = current.speaker ? text(current.speaker) : character.GetName();
+                    ui_.ShowEventLine(speaker, line);
+                }
+                node = current.next;
+                break;
+            }
+            case DialogueGraph::NodeKind::Choice: {
+                std::vector<std::string> options;
+                options.reserve(current.choiceCount);
+                for (std::uint32_t k = 0; k < current.choiceCount; ++k) {
+                    options.push_back(text(script.ChoiceAt(current.firstChoice + k).text));
+                }
+                std::size_t choice = ui_.ShowEventChoices(options);
+                if (ui_.QuitRequested()) break;
+                const DialogueGraph::Choice& picked = script.ChoiceAt(current.firstChoice + static_cast<std::uint32_t>(choice));
+                character.AddAffection(picked.affection);
+                node = picked.next;
+                break;
+            }
+        }
+    }
+    ui_.EndEvent();
+
+    if (character.GetAffection() != affectionBefore) {
+        ui_.PrintSystem("호감도 변화: " + std::to_string(affectionBefore) + " → " +
+                        std::to_string(character.GetAffection()));
+        AutoAdvanceRelationship(character);
+    }
 }
 
 void Game::RestoreChatHistory() {
-    const auto& history = dialogueManager_.GetContext().History();
-    for (const auto& turn : history) {
-        if (turn.speaker == "Player" || turn.speaker == playerName_) {
-            ui_.PrintPlayer(turn.text);
-        } else {
-            ui_.PrintNpc(turn.speaker, turn.text);
+    // 전체 기록을 다시 출력하지 않고 화면에 들어갈 만큼의 최근 턴만 읽어옵니다. (나머지는 /history)
+    ui_.ShowRecentHistory(dialogueManager_.GetContext().Size(),
+                          [this](std::size_t begin, std::size_t end, std::vector<TUI::HistoryEntry>& out) {
+                              CollectHistory(begin, end, out);
+                          });
+}
+
+void Game::CollectHistory(std::size_t begin, std::size_t end, std::vector<TUI::HistoryEntry>& out) const {
+    // 디스크로 내보낸 오래된 턴은 요청된 구간만 읽어옵니다.
+    dialogueManager_.GetContext().ForEachTurn(begin, end, [&](const TurnView& turn) {
+        TUI::HistoryEntry entry;
+        switch (turn.role) {
+            case TurnRole::Player: entry.kind = TUI::HistoryEntry::Kind::Player; break;
+            case TurnRole::Npc: entry.kind = TUI::HistoryEntry::Kind::Npc; break;
+            case TurnRole::System: entry.kind = TUI::HistoryEntry::Kind::System; break;
         }
-    }
+        entry.speaker = turn.speaker;
+        entry.text = turn.text;
+        out.push_back(std::move(entry));
+        return true;
+    });
 }
@@ -1,14 +1,21 @@
 #pragma once
 
+#include <memory>
 #include <string>
 #include <vector>
 #include "Character.h"
+#include "CharacterRoster.h"
+#include "ContentWatcher.h"
 #include "Event.h"
+#include "EventEngine.h"
+#include "SaveWorker.h"
+#include "SlotMap.h"
 #include "TUI.h"
 
 class Config;
 class DialogueManager;
 class LLMClient;
+class NpcReply;
 class SaveSystem;
 
 /**
@@ -26,29 +33,51 @@ public:
 
 private:
     void ProcessTurn(const std::string& userInput);
+    std::string AwaitNpcResponse(const nlohmann::json& messages, const Character& character, bool stream);
     bool HandleMetaCommand(const std::string& input);
     void SaveProgress();
+    void ReportSaveResults();
+    void Autosave();
     void LoadProgress();
     void AutoAdvanceRelationship(Character& character);
+
+    // 모델, 마지막 응답의 속도와 토큰 수, 호감도를 상태 표시줄에 반영합니다.
+    void RefreshStatus();
     void RunGameLoop();
     void PromptLoadSelection();
+    std::string PromptCharacterSelection();
+    void ActivateAssets(const std::string& characterId);
+    void BindEvents();
+    void ApplyContentUpdates();
+    Character* ActiveCharacter();
     
     // 이벤트 시스템
-    void LoadEvents(const std::string& filePath);
     void CheckAndTriggerEvents();
-    void PlayEvent(const Event& event);
+    void PlayEvent(std::size_t index, Character& character);
     void RestoreChatHistory();
+    void CollectHistory(std::size_t begin, std::size_t end, std::vector<TUI::HistoryEntry>& out) const;
 
     Config& config_;
     TUI& ui_;
     DialogueManager& dialogueManager_;
     LLMClient& llmClient_;
     SaveSystem& saveSystem_;
+    SaveWorker saveWorker_;  // 저장은 이 작업자를 거쳐 백그라운드에서 수행됩니다.
 
-    std::vector<Character> characters_;
-    Character* activeCharacter_;
+    CharacterRoster roster_;
+    ContentWatcher contentWatcher_;  // 개별 파일 모드에서 data/ 편집을 감지해 재시작 없이 반영합니다.
+    SlotMap<Character> characters_;  // 핸들로 접근하므로 캐릭터가 늘어나도 매달린 포인터가 생기지 않습니다.
+    SlotHandle activeCharacter_;
+    std::shared_ptr<const CharacterAssets> activeAssets_;  // 대화 중인 캐릭터의 프롬프트와 이벤트
+    std::string activeCharacterId_;
+    EventProgress eventProgress_;                          // activeAssets_의 이벤트 중 발생한 것
     std::string playerName_;
     bool isRunning_;
-    
-    std::vector<Event> events_;
+
+    EventLoop::TimerId autosaveTimer_ = 0;
+    bool awaitingInput_ = false;  // 플레이어 입력을 기다리는 중(자동 저장해도 안전한 때)인지
+    bool autosaveDue_ = false;    // 자동 저장 시각이 지났지만 아직 저장하지 못했는지
+    std::size_t savedTurns_ = 0;  // 마지막으로 저장을 요청했을 때의 턴 수
+
+    std::shared_ptr<const NpcReply> lastReply_;  // 상태 표시줄에 수치를 보여줄 응답 (받는 중일 수 있음)
 };
@@ -1,25 +1,211 @@
 #pragma once
 
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
-#include <fstream>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
 #include <iostream>
 #include <nlohmann/json.hpp>
 
+#include "FileIO.h"
+
+/**
+ * 지정한 배열 하나를 원소 단위로 넘겨주는 SAX 처리기입니다.
+ * 나머지 값은 일반 DOM으로 만들지만, 대상 배열의 원소는 하나씩 만들어 콜백에 넘긴 뒤 버리므로
+ * 수 MB짜리 대화 기록이나 이벤트 묶음도 원소 하나 크기의 메모리만 사용합니다.
+ */
+class JsonStreamingSax {
+public:
+    using ElementHandler = std::function<bool(nlohmann::json&&)>;
+
+    // `arrayKey`가 비어 있으면 루트 배열을, 아니면 루트 객체의 `arrayKey` 배열을 스트리밍합니다.
+    JsonStreamingSax(nlohmann::json& root, std::string arrayKey, ElementHandler onElement)
+        : root_(root), arrayKey_(std::move(arrayKey)), onElement_(std::move(onElement)) {}
+
+    bool null() { return Put(nullptr, false); }
+    bool boolean(bool value) { return Put(value, false); }
+    bool number_integer(nlohmann::json::number_integer_t value) { return Put(value, false); }
+    bool number_unsigned(nlohmann::json::number_unsigned_t value) { return Put(value, false); }
+    bool number_float(nlohmann::json::number_float_t value, const nlohmann::json::string_t&) { return Put(value, false); }
+    bool string(nlohmann::json::string_t& value) { return Put(std::move(value), false); }
+    bool binary(nlohmann::json::binary_t& value) { return Put(std::move(value), false); }
+
+    bool start_object(std::size_t) { return Put(nlohmann::json::object(), true); }
+    bool key(nlohmann::json::string_t& name) {
+        if (stack_.size() == 1) lastRootKey_ = name;
+        keySlot_ = &(*stack_.back())[name];
+        return true;
+    }
+    bool end_object() { return Close(); }
+
+    bool start_array(std::size_t) {
+        bool stream = !streamArray_ &&
+                      (arrayKey_.empty() ? stack_.empty() : stack_.size() == 1 && lastRootKey_ == arrayKey_);
+        if (!Put(nlohmann::json::array(), true)) return false;
+        if (stream) streamArray_ = stack_.back();
+        return true;
+    }
+    bool end_array() { return Close(); }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::json::exception& e) {
+        error_ = e.what();
+        return false;
+    }
+
+    const std::string& Error() const { return error_; }
+    std::size_t Emitted() const { return emitted_; }
+
+private:
+    template <typename Value>
+    bool Put(Value&& value, bool container) {
+        nlohmann::json* slot;
+        if (stack_.empty()) {
+            root_ = nlohmann::json(std::forward<Value>(value));
+            slot = &root_;
+        } else if (stack_.back() == streamArray_) {
+            element_ = nlohmann::json(std::forward<Value>(value));
+            slot = &element_;
+        } else if (stack_.back()->is_array()) {
+            stack_.back()->emplace_back(std::forward<Value>(value));
+            slot = &stack_.back()->back();
+        } else {
+            *keySlot_ = nlohmann::json(std::forward<Value>(value));
+            slot = keySlot_;
+        }
+
+        if (container) {
+            stack_.push_back(slot);
+            return true;
+        }
+        return slot == &element_ ? Emit() : true;
+    }
+
+    bool Close() {
+        nlohmann::json* done = stack_.back();
+        stack_.pop_back();
+        if (done == streamArray_) {
+            streamArray_ = nullptr;
+            return true;
+        }
+        return done == &element_ ? Emit() : true;
+    }
+
+    bool Emit() {
+        ++emitted_;
+        bool keepGoing = onElement_(std::move(element_));
+        element_ = nullptr;
+        if (!keepGoing) error_ = "중단됨";
+        return keepGoing;
+    }
+
+    nlohmann::json& root_;
+    std::string arrayKey_;
+    ElementHandler onElement_;
+
+    std::vector<nlohmann::json*> stack_;
+    nlohmann::json* keySlot_ = nullptr;
+    nlohmann::json* streamArray_ = nullptr;
+    nlohmann::json element_;
+    std::string lastRootKey_;
+    std::string error_;
+    std::size_t emitted_ = 0;
+};
+
 /**
  * JSON 파일을 읽고 쓰기 위한 간단한 헬퍼 클래스입니다.
+ *
+ * 저장한 파일 끝에는 `//crc32:xxxxxxxx` 줄이 붙으며, 로드할 때 본문과 대조합니다.
+ * 체크섬 줄이 없는 파일(설정, 에셋, 이전 세이브)은 검증 없이 그대로 읽습니다.
  */
 class JsonHelper {
 public:
     // 디스크에서 JSON을 로드하여 `out` 변수에 저장합니다.
+    // 파일이 없거나 손상되었으면 직전 세대(`<path>.bak`)에서 복구를 시도합니다.
     static inline bool LoadFromFile(const std::string& path, nlohmann::json& out) {
-        std::ifstream input(path);
-        if (!input.is_open()) {
+        if (LoadVerified(path, out)) {
+            return true;
+        }
+        std::string backup = path + ".bak";
+        std::error_code ec;
+        if (std::filesystem::exists(backup, ec) && LoadVerified(backup, out)) {
+            std::cerr << "[JsonHelper] 직전 저장본에서 복구했습니다: " << backup << '\n';
+            return true;
+        }
+        return false;
+    }
+
+    // 큰 배열 하나를 DOM으로 만들지 않고 원소 단위로 `onElement`에 넘기며 로드합니다.
+    // `arrayKey`가 비어 있으면 루트 배열을, 아니면 루트 객체의 해당 키를 스트리밍하며, `out`에는 빈 배열로 남습니다.
+    // 원소를 넘기기 전에 실패한 경우에만 직전 세대(`<path>.bak`)로 복구를 시도합니다.
+    static inline bool StreamFromFile(const std::string& path, const std::string& arrayKey, nlohmann::json& out,
+                                      const JsonStreamingSax::ElementHandler& onElement) {
+        std::size_t emitted = 0;
+        if (StreamVerified(path, arrayKey, out, onElement, emitted)) {
+            return true;
+        }
+        std::string backup = path + ".bak";
+        std::error_code ec;
+        if (emitted == 0 && std::filesystem::exists(backup, ec) &&
+            StreamVerified(backup, arrayKey, out, onElement, emitted)) {
+            std::cerr << "[JsonHelper] 직전 저장본에서 복구했습니다: " << backup << '\n';
+            return true;
+        }
+        return false;
+    }
+
+    // JSON 데이터를 지정된 파일 경로에 원자적으로 저장합니다. (체크섬 포함)
+    static inline bool SaveToFile(const std::string& path, const nlohmann::json& data) {
+        std::string body = data.dump(2);
+        char trailer[32];
+        std::snprintf(trailer, sizeof(trailer), "%s%08x\n", kChecksumMarker, FileIO::Crc32(body));
+        body += trailer;
+        if (!FileIO::WriteAtomic(path, body)) {
+            std::cerr << "[JsonHelper] 파일을 쓸 수 없습니다: " << path << '\n';
+            return false;
+        }
+        return true;
+    }
+
+private:
+    static constexpr const char* kChecksumMarker = "\n//crc32:";
+
+    // 파일을 메모리 매핑으로 열고, 체크섬 줄이 있으면 검증한 뒤 본문을 `body`로 돌려줍니다.
+    // 파서는 `body`를 복사 없이 바로 읽습니다.
+    static inline bool ReadVerified(const std::string& path, MappedFile& file, std::string_view& body) {
+        if (!file.Open(path)) {
             std::cerr << "[JsonHelper] 파일을 열 수 없습니다: " << path << '\n';
             return false;
         }
+
+        body = file.View();
+        size_t marker = body.rfind(kChecksumMarker);
+        if (marker != std::string_view::npos) {
+            std::string_view digits = body.substr(marker + std::char_traits<char>::length(kChecksumMarker));
+            while (!digits.empty() && (digits.back() == '\n' || digits.back() == '\r')) digits.remove_suffix(1);
+            body = body.substr(0, marker);
+            std::uint32_t expected = static_cast<std::uint32_t>(std::strtoul(std::string(digits).c_str(), nullptr, 16));
+            if (digits.size() != 8 || FileIO::Crc32(body) != expected) {
+                std::cerr << "[JsonHelper] 체크섬 불일치(" << path << "): 파일이 손상되었습니다.\n";
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static inline bool LoadVerified(const std::string& path, nlohmann::json& out) {
+        MappedFile file;
+        std::string_view body;
+        if (!ReadVerified(path, file, body)) {
+            return false;
+        }
+
         try {
-            input >> out;
+            out = nlohmann::json::parse(body.begin(), body.end());
         } catch (const std::exception& e) {
             std::cerr << "[JsonHelper] JSON 파싱 오류(" << path << "): " << e.what() << '\n';
             return false;
@@ -27,14 +213,20 @@ public:
         return true;
     }
 
-    // JSON 데이터를 지정된 파일 경로에 저장합니다.
-    static inline bool SaveToFile(const std::string& path, const nlohmann::json& data) {
-        std::ofstream output(path);
-        if (!output.is_open()) {
-            std::cerr << "[JsonHelper] 파일을 쓸 수 없습니다: " << path << '\n';
+    static inline bool StreamVerified(const std::string& path, const std::string& arrayKey, nlohmann::json& out,
+                                      const JsonStreamingSax::ElementHandler& onElement, std::size_t& emitted) {
+        MappedFile file;
+        std::string_view body;
+        if (!ReadVerified(path, file, body)) {
             return false;
         }
-        output << data.dump(2);
-        return true;
+
+        JsonStreamingSax sax(out, arrayKey, onElement);
+        bool ok = nlohmann::json::sax_parse(body.begin(), body.end(), &sax);
+        emitted = sax.Emitted();
+        if (!ok) {
+            std::cerr << "[JsonHelper] JSON 파싱 오류(" << path << "): " << sax.Error() << '\n';
+        }
+        return ok;
     }
 };
@@ -1,10 +1,260 @@
 #include "LLMClient.h"
 #include "Config.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <functional>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace {
+// 후보를 기다리는 동안 취소 여부를 확인하는 간격
+constexpr std::chrono::milliseconds kCancelPollInterval(100);
+
+// 후보 요청 스레드들과 게임 스레드가 공유하는 수집 상태입니다.
+// 마감 시간 이후에 끝나는 요청도 안전하게 결과를 버릴 수 있도록 shared_ptr로 수명을 관리합니다.
+struct CandidateBatch {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<std::string> replies;
+    std::string lastError;
+    LLMUsage usage;
+    int finished = 0;
+    std::atomic<bool> stop{false};  // 후보를 고르거나 취소했으면 남은 요청을 멈춥니다.
+};
+
+// Ollama 응답(스트리밍이면 마지막 조각)에 든 토큰 수를 읽습니다.
+LLMUsage OllamaUsage(const nlohmann::json& j) {
+    LLMUsage usage;
+    if (j.contains("prompt_eval_count")) usage.promptTokens = j["prompt_eval_count"].get<int>();
+    if (j.contains("eval_count")) usage.completionTokens = j["eval_count"].get<int>();
+    return usage;
+}
+
+// OpenAI 응답의 `usage`를 읽습니다. 캐시된 프롬프트 토큰은 지원하는 모델에서만 옵니다.
+LLMUsage OpenAIUsage(const nlohmann::json& res) {
+    LLMUsage usage;
+    if (!res.contains("usage") || !res["usage"].is_object()) return usage;
+    const nlohmann::json& u = res["usage"];
+    usage.promptTokens = u.value("prompt_tokens", -1);
+    usage.completionTokens = u.value("completion_tokens", -1);
+    if (u.contains("prompt_tokens_details") && u["prompt_tokens_details"].is_object()) {
+        usage.cachedTokens = u["prompt_tokens_details"].value("cached_tokens", -1);
+    }
+    return usage;
+}
+
+ollama::messages ToOllamaMessages(const nlohmann::json& jsonMessages) {
+    ollama::messages msgs;
+    for (const auto& item : jsonMessages) {
+        std::string role = item.value("role", "user");
+        std::string content = item.value("content", "");
+        msgs.push_back(ollama::message(role, content));
+    }
+    return msgs;
+}
+
+// 요청 하나의 결과(성공한 응답들 또는 오류)를 배치에 기록하고 대기 중인 스레드를 깨웁니다.
+void ReportCandidates(CandidateBatch& batch, std::vector<std::string> replies, std::string error,
+                      const LLMUsage& usage) {
+    {
+        std::lock_guard<std::mutex> lock(batch.mutex);
+        for (auto& reply : replies) batch.replies.push_back(std::move(reply));
+        if (!error.empty()) batch.lastError = std::move(error);
+        batch.usage.Add(usage);
+        ++batch.finished;
+    }
+    batch.cv.notify_all();
+}
+
+// OpenAI에 완성된 응답 하나를 요청하고 응답에 든 토큰 수를 `usage`에 기록합니다.
+std::string SendOpenAI(const std::string& model, const nlohmann::json& jsonMessages, LLMUsage& usage) {
+    try {
+        nlohmann::json payload = {
+            {"model", model},
+            {"messages", jsonMessages}
+        };
+        auto res = openai::chat().create(payload);
+        usage = OpenAIUsage(res);
+
+        if (res.contains("choices") && !res["choices"].empty()) {
+            return res["choices"][0]["message"]["content"].get<std::string>();
+        }
+        if (res.contains("error")) {
+            return "Error: " + res["error"]["message"].get<std::string>();
+        }
+        return "Error: Empty OpenAI response";
+    } catch (const std::exception& e) {
+        return std::string("Error: ") + e.what();
+    }
+}
+
+// 새 요청 스레드를 시작하는 함수입니다. (LLMClient::Spawn)
+using Spawner = std::function<void(std::function<void()>)>;
+
+// 후보 `count`개(2 이상)를 요청해 모읍니다. 후보 요청은 `spawn`으로 시작하며, 어느 스레드에서나 호출할 수 있습니다.
+// 마감 전에 끝난 요청들의 토큰 수 합계를 `usage`에 기록합니다.
+// `cancelled`가 true를 반환하면 기다리기를 그만두고 남은 요청을 멈춥니다.
+std::vector<std::string> CollectCandidates(LLMProvider provider, const std::string& model,
+                                           const nlohmann::json& jsonMessages, int count,
+                                           std::chrono::milliseconds deadline, LLMUsage& usage,
+                                           const std::function<bool()>& cancelled, const Spawner& spawn) {
+    auto batch = std::make_shared<CandidateBatch>();
+    int requests = 0;
+
+    if (provider == LLMProvider::OpenAI) {
+        // OpenAI: `n` 파라미터로 한 번의 요청에서 후보 여러 개를 받습니다.
+        // (openai-cpp의 요청은 중간에 멈출 수 없으므로 취소하면 결과만 버립니다)
+        nlohmann::json payload = {
+            {"model", model},
+            {"messages", jsonMessages},
+            {"n", count}
+        };
+        requests = 1;
+        spawn([batch, payload]() {
+            std::vector<std::string> replies;
+            std::string error;
+            LLMUsage usage;
+            try {
+                auto res = openai::chat().create(payload);
+                usage = OpenAIUsage(res);
+                if (res.contains("choices")) {
+                    for (const auto& choice : res["choices"]) {
+                        if (choice.contains("message") && choice["message"].contains("content")) {
+                            replies.push_back(choice["message"]["content"].get<std::string>());
+                        }
+                    }
+                }
+                if (replies.empty()) {
+                    error = res.contains("error") ? "Error: " + res["error"]["message"].get<std::string>()
+                                                  : "Error: Empty OpenAI response";
+                }
+            } catch (const std::exception& e) {
+                error = std::string("Error: ") + e.what();
+            }
+            ReportCandidates(*batch, std::move(replies), std::move(error), usage);
+        });
+    } else {
+        // Ollama: 후보마다 별도의 연결(Ollama 인스턴스)로 동시에 요청합니다.
+        // 전역 ollama 싱글턴의 httplib 클라이언트는 여러 스레드에서 동시에 쓸 수 없습니다.
+        // 스트리밍으로 받아 조각마다 stop을 확인하므로, 후보를 고르거나 취소하면 생성을 바로 멈춥니다.
+        ollama::messages msgs = ToOllamaMessages(jsonMessages);
+        requests = count;
+        for (int i = 0; i < count; ++i) {
+            nlohmann::json options = {{"options", {{"seed", i + 1}, {"temperature", 0.9}}}};
+            spawn([batch, msgs, options, model]() {
+                std::vector<std::string> replies;
+                std::string error;
+                LLMUsage usage;
+                try {
+                    Ollama server;
+                    std::string reply;
+                    bool done = false;
+                    server.chat(model, msgs, [&](const ollama::response& chunk) {
+                        if (batch->stop) return false;
+                        const nlohmann::json& j = chunk.as_json();
+                        if (j.contains("error")) {
+                            error = "Error: " + j["error"].get<std::string>();
+                            return false;
+                        }
+                        if (j.contains("message") && j["message"].contains("content")) {
+                            reply += j["message"]["content"].get<std::string>();
+                        }
+                        if (j.value("done", false)) {
+                            usage = OllamaUsage(j);
+                            done = true;
+                        }
+                        return true;
+                    }, options);
+                    if (done && !reply.empty()) {
+                        replies.push_back(std::move(reply));
+                    } else if (error.empty()) {
+                        error = batch->stop ? "Error: Candidate request stopped" : "Error: Unexpected Ollama response format";
+                    }
+                } catch (const std::exception& e) {
+                    error = std::string("Error: ") + e.what();
+                }
+                ReportCandidates(*batch, std::move(replies), std::move(error), usage);
+            });
+        }
+    }
+
+    // `limit`까지 `ready`를 기다립니다. 취소를 알아차리도록 짧게 나눠서 기다립니다.
+    std::unique_lock<std::mutex> lock(batch->mutex);
+    bool wasCancelled = false;
+    auto waitUntil = [&](std::chrono::steady_clock::time_point limit, const std::function<bool()>& ready) {
+        while (!ready()) {
+            if (cancelled && cancelled()) {
+                wasCancelled = true;
+                return;
+            }
+            auto now = std::chrono::steady_clock::now();
+            if (now >= limit) return;
+            batch->cv.wait_until(lock, std::min(limit, now + kCancelPollInterval));
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    waitUntil(start + deadline, [&] { return batch->finished == requests; });
+    if (batch->replies.empty() && !wasCancelled) {
+        // 마감 시간이 지났지만 준비된 후보가 없으면 마감 시간만큼만 더 첫 후보(또는 모든 요청의 실패)를 기다립니다.
+        waitUntil(start + deadline * 2, [&] { return !batch->replies.empty() || batch->finished == requests; });
+    }
+    // 결과를 정했으므로 아직 생성 중인 후보는 멈춥니다.
+    batch->stop = true;
+
+    usage = batch->usage;
+    if (wasCancelled) return {"Error: Cancelled"};
+    if (batch->replies.empty()) {
+        if (batch->finished < requests) return {"Error: Candidate replies timed out"};
+        return {batch->lastError.empty() ? "Error: No candidate replies" : batch->lastError};
+    }
+    return batch->replies;
+}
+
+// 응답을 조각 단위로 받아 `onToken`에 넘기고 완성된 응답을 반환합니다. 어느 스레드에서나 호출할 수 있습니다.
+std::string StreamReply(LLMProvider provider, const std::string& model, const nlohmann::json& jsonMessages,
+                        const std::function<bool(const std::string&)>& onToken, LLMUsage& usage) {
+    if (provider == LLMProvider::OpenAI) {
+        // openai-cpp에는 스트리밍 API가 없으므로 완성된 응답을 한 조각으로 넘깁니다.
+        // (전역 클라이언트는 요청을 뮤텍스로 직렬화하므로 다른 스레드에서 써도 안전합니다)
+        std::string reply = SendOpenAI(model, jsonMessages, usage);
+        if (reply.rfind("Error:", 0) != 0) onToken(reply);
+        return reply;
+    }
+
+    std::string reply;
+    std::string error;
+    try {
+        // 전역 ollama 싱글턴의 httplib 클라이언트는 여러 스레드에서 동시에 쓸 수 없으므로 연결을 따로 만듭니다.
+        Ollama server;
+        server.chat(model, ToOllamaMessages(jsonMessages), [&](const ollama::response& chunk) {
+            const nlohmann::json& j = chunk.as_json();
+            if (j.contains("error")) {
+                error = "Error: " + j["error"].get<std::string>();
+                return false;
+            }
+            // 토큰 수는 마지막(done) 조각에만 들어 있습니다.
+            if (j.value("done", false)) usage = OllamaUsage(j);
+            if (!j.contains("message") || !j["message"].contains("content")) return true;
+            std::string token = j["message"]["content"].get<std::string>();
+            if (token.empty()) return true;
+            reply += token;
+            return onToken(token);
+        });
+    } catch (const std::exception& e) {
+        error = std::string("Error: ") + e.what();
+    }
+    if (!error.empty()) return error;
+    return reply.empty() ? std::string("Error: Unexpected Ollama response format") : reply;
+}
+}  // 익명 네임스페이스 종료
 
 LLMClient::LLMClient(const Config& config)
-    : model_(config.GetModel()) {
+    : model_(config.GetModel()),
+      shutdown_(std::make_shared<std::atomic<bool>>(false)) {
 
     std::string apiKey = config.GetApiKey();
     
@@ -22,6 +272,36 @@ LLMClient::LLMClient(const Config& config)
 }
 
 LLMClient::~LLMClient() {
+    *shutdown_ = true;
+    // 합류를 기다리는 동안 요청 스레드가 후보 요청을 더 시작할 수 있으므로 목록이 빌 때까지 반복합니다.
+    while (true) {
+        std::vector<Worker> workers;
+        {
+            std::lock_guard<std::mutex> lock(workersMutex_);
+            workers.swap(workers_);
+        }
+        if (workers.empty()) break;
+        for (auto& worker : workers) worker.thread.join();
+    }
+}
+
+void LLMClient::Spawn(std::function<void()> work) {
+    auto finished = std::make_shared<std::atomic<bool>>(false);
+    std::lock_guard<std::mutex> lock(workersMutex_);
+    // 끝난 스레드는 여기서 정리하므로 목록은 동시에 진행 중인 요청 수만큼만 남습니다.
+    for (auto it = workers_.begin(); it != workers_.end();) {
+        if (*it->finished) {
+            it->thread.join();
+            it = workers_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    workers_.push_back(Worker{std::thread([work = std::move(work), finished]() {
+                                  work();
+                                  *finished = true;
+                              }),
+                              finished});
 }
 
 void LLMClient::SetApiKey(const std::string& key) {
@@ -56,40 +336,25 @@ bool LLMClient::TestConnection() {
     }
 }
 
-std::string LLMClient::SendMessage(const nlohmann::json& jsonMessages) {
-    try {
-        if (provider_ == LLMProvider::Ollama) {
-            ollama::messages msgs;
-            for (const auto& item : jsonMessages) {
-                std::string role = item.value("role", "user");
-                std::string content = item.value("content", "");
-                msgs.push_back(ollama::message(role, content));
-            }
-            ollama::response response = ollama::chat(model_, msgs);
-            
-            // Ollama: 필드에 안전하게 접근하기 위해 응답을 json으로 변환
-            nlohmann::json j = response; 
-            if (j.contains("message") && j["message"].contains("content")) {
-                return j["message"]["content"].get<std::string>();
-            }
-            return "Error: Unexpected Ollama response format";
+void LLMClient::RequestAsync(const nlohmann::json& messages, int count, std::chrono::milliseconds deadline,
+                             std::function<bool(const std::string&)> onToken,
+                             std::function<void(std::vector<std::string>, LLMUsage)> onDone,
+                             std::function<bool()> cancelled) {
+    // 요청 스레드는 설정을 복사해 가고, 소멸 중이면 호출자가 취소하지 않았어도 요청을 멈춥니다.
+    std::shared_ptr<std::atomic<bool>> shutdown = shutdown_;
+    auto stop = [shutdown, cancelled = std::move(cancelled)]() { return *shutdown || (cancelled && cancelled()); };
+    Spawner spawn = [this](std::function<void()> work) { Spawn(std::move(work)); };
+    Spawn([provider = provider_, model = model_, messages, count, deadline, spawn, stop,
+           onToken = std::move(onToken), onDone = std::move(onDone)]() {
+        LLMUsage usage;
+        if (count > 1) {
+            std::vector<std::string> replies = CollectCandidates(provider, model, messages, count, deadline, usage, stop, spawn);
+            onDone(std::move(replies), usage);
         } else {
-            // OpenAI
-            nlohmann::json payload = {
-                {"model", model_},
-                {"messages", jsonMessages}
-            };
-            auto res = openai::chat().create(payload);
-            
-            if (res.contains("choices") && !res["choices"].empty()) {
-                return res["choices"][0]["message"]["content"].get<std::string>();
-            }
-            if (res.contains("error")) {
-                return "Error: " + res["error"]["message"].get<std::string>();
-            }
-            return "Error: Empty OpenAI response";
+            std::string reply = StreamReply(provider, model, messages, [&](const std::string& token) {
+                return !stop() && onToken(token);
+            }, usage);
+            onDone({std::move(reply)}, usage);
         }
-    } catch (const std::exception& e) {
-        return std::string("Error: ") + e.what();
-    }
+    });
 }
@@ -1,5 +1,15 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "LLMUsage.h"
 #include "ollama.hpp"
 #include "openai.hpp"
 
@@ -12,17 +22,51 @@ enum class LLMProvider {
 
 /**
  * openai-cpp 또는 ollama-hpp를 사용하여 LLM 상호작용을 처리합니다.
+ * 요청 스레드는 모두 이 객체가 소유하며, 소멸할 때 진행 중인 요청을 멈추고 스레드가 끝나기를 기다립니다.
+ * 따라서 전역 클라이언트(openai, ollama)가 정리된 뒤에 요청 스레드가 남아 있는 일이 없습니다.
  */
 class LLMClient {
 public:
     explicit LLMClient(const Config& config);
+
+    // 진행 중인 요청을 멈추고 요청 스레드를 모두 합류(join)합니다.
+    // (openai-cpp 요청은 중간에 멈출 수 없으므로 그 요청이 끝날 때까지 기다립니다)
     ~LLMClient();
 
+    LLMClient(const LLMClient&) = delete;
+    LLMClient& operator=(const LLMClient&) = delete;
+
     bool TestConnection();
     void SetApiKey(const std::string& key);
-    std::string SendMessage(const nlohmann::json& messages);
+
+    LLMProvider GetProvider() const { return provider_; }
+    const std::string& GetModel() const { return model_; }
+
+    // 응답을 별도 스레드에서 받습니다. 바로 반환하며, 콜백은 모두 요청 스레드에서 호출됩니다.
+    // count가 1 이하이면 응답 조각을 받을 때마다 onToken을 호출하고, onToken이 false를 반환하면 요청을
+    // 멈춥니다. (OpenAI는 완성된 응답을 한 조각으로 넘깁니다)
+    // 2 이상이면 후보 `count`개를 병렬로 요청해 `deadline` 안에 도착한 후보들을 모읍니다. 그때까지 아무것도
+    // 도착하지 않았다면 마감 시간만큼 더 기다려 가장 먼저 도착하는 후보 하나를 받고, 고른 뒤 남은 요청은 멈춥니다.
+    // 기다리는 동안 `cancelled`가 true를 반환하면 남은 후보 요청을 멈춥니다.
+    // 끝나면 받은 응답들(실패하면 "Error: ..." 하나)과 토큰 사용량으로 onDone을 호출합니다.
+    void RequestAsync(const nlohmann::json& messages, int count, std::chrono::milliseconds deadline,
+                      std::function<bool(const std::string&)> onToken,
+                      std::function<void(std::vector<std::string>, LLMUsage)> onDone,
+                      std::function<bool()> cancelled = nullptr);
 
 private:
+    struct Worker {
+        std::thread thread;
+        std::shared_ptr<std::atomic<bool>> finished;
+    };
+
+    // 요청 스레드를 시작합니다. 이미 끝난 스레드는 이때 합류시켜 정리합니다. (어느 스레드에서나 호출 가능)
+    void Spawn(std::function<void()> work);
+
     std::string model_;
     LLMProvider provider_;
+
+    std::mutex workersMutex_;
+    std::vector<Worker> workers_;
+    std::shared_ptr<std::atomic<bool>> shutdown_;  // 소멸 중이면 true (요청 스레드도 읽습니다)
 };
@@ -0,0 +1,23 @@
+#pragma once
+
+/**
+ * 응답 하나에 든 토큰 수입니다. API가 알려주지 않은 값은 -1입니다.
+ * (OpenAI `usage`, Ollama `prompt_eval_count`/`eval_count`)
+ */
+struct LLMUsage {
+    int promptTokens = -1;
+    int completionTokens = -1;
+    int cachedTokens = -1;  // 프롬프트 중 제공자의 프롬프트 캐시에서 재사용한 토큰 (OpenAI만 알려줌)
+
+    // 다른 요청(후보)의 사용량을 더합니다. 한쪽만 알려준 값은 그 값을 씁니다.
+    void Add(const LLMUsage& other) {
+        AddCount(promptTokens, other.promptTokens);
+        AddCount(completionTokens, other.completionTokens);
+        AddCount(cachedTokens, other.cachedTokens);
+    }
+
+private:
+    static void AddCount(int& total, int value) {
+        if (value >= 0) total = total < 0 ? value : total + value;
+    }
+};
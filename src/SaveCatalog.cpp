@@ -0,0 +1,193 @@
+#include "SaveCatalog.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <utility>
+
+#include "FileIO.h"
+
+namespace {
+constexpr const char* kCatalogFileName = "catalog.idx";
+
+// 덮어쓴 줄이 살아 있는 항목 수를 이만큼 넘으면 색인을 다시 씁니다.
+constexpr std::size_t kRewriteSlack = 64;
+}  // 익명 네임스페이스 종료
+
+void to_json(nlohmann::json& j, const SaveCatalogEntry& entry) {
+    j = nlohmann::json{
+        {"file", entry.file},
+        {"character", entry.character},
+        {"player", entry.playerName},
+        {"affection", entry.affection},
+        {"stage", entry.stage},
+        {"turns", entry.turns},
+        {"savedAt", entry.savedAt}
+    };
+}
+
+void from_json(const nlohmann::json& j, SaveCatalogEntry& entry) {
+    entry.file = j.value("file", "");
+    entry.character = j.value("character", "");
+    entry.playerName = j.value("player", "");
+    entry.affection = j.value("affection", 0);
+    entry.stage = j.value("stage", 0);
+    entry.turns = j.value("turns", static_cast<std::size_t>(0));
+    entry.savedAt = j.value("savedAt", static_cast<std::int64_t>(0));
+}
+
+SaveCatalog::SaveCatalog(std::string directory)
+    : path_((std::filesystem::path(directory) / kCatalogFileName).string()),
+      lineCount_(0),
+      pruned_(0) {}
+
+bool SaveCatalog::Load() {
+    entries_.clear();
+    byFile_.clear();
+    lineCount_ = 0;
+
+    std::string contents;
+    if (!FileIO::ReadAll(path_, contents)) {
+        return false;
+    }
+
+    bool damaged = false;
+    std::string_view rest = contents;
+    while (!rest.empty()) {
+        std::size_t newline = rest.find('\n');
+        std::string_view line = rest.substr(0, newline);
+        rest = newline == std::string_view::npos ? std::string_view{} : rest.substr(newline + 1);
+        if (line.empty()) continue;
+
+        std::string_view body;
+        nlohmann::json record;
+        if (FileIO::ParseChecksummedLine(line, body)) {
+            record = nlohmann::json::parse(body.begin(), body.end(), nullptr, false);
+        }
+        if (!record.is_object()) {
+            // 색인은 세이브에서 다시 만들 수 있으므로 손상된 줄만 버리고 계속 읽습니다.
+            damaged = true;
+            continue;
+        }
+        if (record.value("removed", false)) {
+            Erase(record.value("file", ""));
+        } else {
+            Apply(record.get<SaveCatalogEntry>());
+        }
+        ++lineCount_;
+    }
+
+    if (damaged) {
+        std::cerr << "[SaveCatalog] 손상된 색인 항목을 건너뛰었습니다: " << path_ << '\n';
+        Rewrite();
+    }
+    return true;
+}
+
+bool SaveCatalog::Upsert(const SaveCatalogEntry& entry) {
+    return UpsertAll({entry});
+}
+
+bool SaveCatalog::UpsertAll(const std::vector<SaveCatalogEntry>& entries) {
+    if (entries.empty()) return true;
+
+    std::string batch;
+    for (const auto& entry : entries) {
+        FileIO::AppendChecksummedLine(batch, nlohmann::json(entry).dump());
+        Apply(entry);
+    }
+    lineCount_ += entries.size();
+
+    if (lineCount_ > entries_.size() * 2 + kRewriteSlack) {
+        return Rewrite();
+    }
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(path_).parent_path(), ec);
+    return FileIO::AppendDurable(path_, batch);
+}
+
+bool SaveCatalog::Remove(const std::string& file) {
+    if (byFile_.count(file) == 0) return true;
+    Erase(file);
+    ++lineCount_;
+    if (lineCount_ > entries_.size() * 2 + kRewriteSlack) {
+        return Rewrite();
+    }
+    std::string line;
+    FileIO::AppendChecksummedLine(line, nlohmann::json{{"file", file}, {"removed", true}}.dump());
+    return FileIO::AppendDurable(path_, line);
+}
+
+std::size_t SaveCatalog::TakePruned() {
+    return std::exchange(pruned_, 0);
+}
+
+std::size_t SaveCatalog::Size() const {
+    return entries_.size();
+}
+
+std::vector<SaveCatalogEntry> SaveCatalog::Page(std::size_t offset, std::size_t limit) const {
+    // 최신 저장이 맨 뒤에 있으므로 뒤에서부터 구간만 복사합니다.
+    std::vector<SaveCatalogEntry> page;
+    if (offset >= entries_.size()) return page;
+    std::size_t end = std::min(entries_.size(), offset + limit);
+    page.reserve(end - offset);
+    for (std::size_t i = offset; i < end; ++i) {
+        page.push_back(entries_[entries_.size() - 1 - i]);
+    }
+    return page;
+}
+
+void SaveCatalog::Apply(SaveCatalogEntry entry) {
+    // entries_는 오래된 저장부터 최신 저장 순서입니다. 갱신된 항목은 맨 뒤로 옮깁니다.
+    auto it = byFile_.find(entry.file);
+    if (it != byFile_.end()) {
+        std::size_t index = it->second;
+        if (index + 1 == entries_.size()) {
+            entries_[index] = std::move(entry);
+            return;
+        }
+        entries_.erase(entries_.begin() + static_cast<std::ptrdiff_t>(index));
+        for (std::size_t i = index; i < entries_.size(); ++i) {
+            byFile_[entries_[i].file] = i;
+        }
+    }
+    byFile_[entry.file] = entries_.size();
+    entries_.push_back(std::move(entry));
+}
+
+void SaveCatalog::Erase(const std::string& file) {
+    auto it = byFile_.find(file);
+    if (it == byFile_.end()) return;
+    std::size_t index = it->second;
+    byFile_.erase(it);
+    entries_.erase(entries_.begin() + static_cast<std::ptrdiff_t>(index));
+    for (std::size_t i = index; i < entries_.size(); ++i) {
+        byFile_[entries_[i].file] = i;
+    }
+}
+
+bool SaveCatalog::Rewrite() {
+    // 게임 밖에서 지운 세이브는 다시 쓰는 김에 뺍니다. (색인은 세이브 디렉토리 안에 있음)
+    namespace fs = std::filesystem;
+    fs::path directory = fs::path(path_).parent_path();
+    std::vector<std::string> missing;
+    for (const auto& entry : entries_) {
+        std::error_code ec;
+        if (!fs::exists(directory / entry.file, ec)) missing.push_back(entry.file);
+    }
+    for (const auto& file : missing) Erase(file);
+    pruned_ += missing.size();
+
+    std::string contents;
+    for (const auto& entry : entries_) {
+        FileIO::AppendChecksummedLine(contents, nlohmann::json(entry).dump());
+    }
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(path_).parent_path(), ec);
+    if (!FileIO::WriteAtomic(path_, contents)) {
+        return false;
+    }
+    lineCount_ = entries_.size();
+    return true;
+}
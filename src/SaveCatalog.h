@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+/**
+ * 세이브 파일 하나의 요약 정보입니다. 로드 메뉴는 파일을 열지 않고 이 정보만 표시합니다.
+ */
+struct SaveCatalogEntry {
+    std::string file;
+    std::string character;
+    std::string playerName;
+    int affection = 0;
+    int stage = 0;
+    std::size_t turns = 0;
+    std::int64_t savedAt = 0;  // 유닉스 시간(초)
+};
+
+void to_json(nlohmann::json& j, const SaveCatalogEntry& entry);
+void from_json(const nlohmann::json& j, SaveCatalogEntry& entry);
+
+/**
+ * 세이브 디렉토리의 `catalog.idx`에 세이브별 요약을 유지하는 색인입니다.
+ * 저장할 때마다 체크섬 줄 하나만 덧붙이고, 같은 파일의 뒤쪽 줄이 앞쪽 줄을 덮어씁니다.
+ * 덮어쓴 줄이 쌓이면 살아 있는 항목만으로 다시 쓰며, 이때 게임 밖에서 지운 세이브도 함께 정리합니다.
+ */
+class SaveCatalog {
+public:
+    explicit SaveCatalog(std::string directory);
+
+    // 색인 파일을 읽습니다. 파일이 없으면 false를 반환하며, 이때 호출자가 색인을 재구성해야 합니다.
+    bool Load();
+
+    // 항목을 추가하거나 같은 파일의 항목을 갱신합니다.
+    bool Upsert(const SaveCatalogEntry& entry);
+
+    // 여러 항목을 한 번에 기록합니다. (재구성용)
+    bool UpsertAll(const std::vector<SaveCatalogEntry>& entries);
+
+    // 파일의 항목을 뺍니다. (세이브 파일이 없어졌을 때) 삭제 표시 줄 하나를 덧붙입니다.
+    bool Remove(const std::string& file);
+
+    // 마지막 호출 이후 세이브 파일이 없어져 뺀 항목 수를 반환하고 0으로 되돌립니다.
+    std::size_t TakePruned();
+
+    // 전체 항목 수를 반환합니다.
+    std::size_t Size() const;
+
+    // 최신 저장 순으로 [offset, offset + limit) 구간의 항목을 반환합니다.
+    std::vector<SaveCatalogEntry> Page(std::size_t offset, std::size_t limit) const;
+
+private:
+    void Apply(SaveCatalogEntry entry);
+    void Erase(const std::string& file);
+    bool Rewrite();
+
+    std::string path_;
+    std::vector<SaveCatalogEntry> entries_;
+    std::unordered_map<std::string, std::size_t> byFile_;
+    std::size_t lineCount_;
+    std::size_t pruned_;
+};
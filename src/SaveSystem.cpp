@@ -1,90 +1,767 @@
 #include "SaveSystem.h"
 
+#include <algorithm>
 #include <filesystem>
 #include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include <iomanip>
 #include <sstream>
 
 #include "Character.h"
+#include "ChunkStore.h"
+#include "Config.h"
 #include "DialogueManager.h"
+#include "FileIO.h"
 #include "JsonHelper.h"
 
 namespace {
-    nlohmann::json Serialize(const Character& character, const DialogueContext& context) {
-        nlohmann::json data = character; // 자동 변환 사용
-        
-        nlohmann::json history = nlohmann::json::array();
-        for (const auto& turn : context.History()) {
-            history.push_back({{"speaker", turn.speaker}, {"text", turn.text}});
+    const char* TurnRoleName(TurnRole role) {
+        switch (role) {
+            case TurnRole::Player: return "player";
+            case TurnRole::Npc: return "npc";
+            case TurnRole::System: return "system";
+        }
+        return "npc";
+    }
+
+    nlohmann::json TurnToJson(const TurnView& turn) {
+        return {
+            {"role", TurnRoleName(turn.role)},
+            {"speaker", turn.speaker},
+            {"text", turn.text},
+            {"ts", turn.timestamp},
+            {"tokens", turn.tokenCount},
+            {"delta", turn.affectionDelta}
+        };
+    }
+
+    void AddTurnFromJson(const nlohmann::json& entry, const std::string& characterName, DialogueContext& context) {
+        std::string speaker = entry.value("speaker", "Unknown");
+        TurnRole role;
+        if (entry.contains("role")) {
+            std::string name = entry.value("role", "npc");
+            role = name == "player" ? TurnRole::Player
+                 : name == "system" ? TurnRole::System
+                                    : TurnRole::Npc;
+        } else {
+            // 역할 정보가 없는 이전 형식: 캐릭터 이름이 아니면 플레이어로 간주합니다.
+            role = speaker == characterName ? TurnRole::Npc : TurnRole::Player;
         }
-        data["history"] = history;
+        context.AddTurn(role, speaker, entry.value("text", ""),
+                        entry.value("delta", 0), entry.value("ts", static_cast<std::int64_t>(0)));
+    }
+
+    nlohmann::json SerializeHistory(const DialogueContext& context) {
+        nlohmann::json history = nlohmann::json::array();
+        history.get_ref<nlohmann::json::array_t&>().reserve(context.Size());
+        context.ForEachTurn(0, context.Size(), [&](const TurnView& turn) {
+            history.push_back(TurnToJson(turn));
+            return true;
+        });
+        return history;
+    }
+
+    // 플레이어 이름이 기록되지 않은 이전 세이브를 위해 첫 플레이어 턴의 화자를 찾습니다.
+    std::string FindPlayerName(const DialogueContext& context) {
+        std::string playerName;
+        context.ForEachTurn(0, context.Size(), [&](const TurnView& turn) {
+            if (turn.role != TurnRole::Player) return true;
+            playerName = std::string(turn.speaker);
+            return false;
+        });
+        return playerName;
+    }
+
+    nlohmann::json Serialize(const Character& character, const DialogueContext& context, const std::string& playerName) {
+        nlohmann::json data = character; // 자동 변환 사용
+        data["playerName"] = playerName;
+        data["history"] = SerializeHistory(context);
         return data;
     }
 
-    void Deserialize(const nlohmann::json& data, Character& character, DialogueContext& context) {
-        character = data.get<Character>(); // 자동 변환 사용
-        
+    // JSON 세이브를 읽습니다. 대화 기록 배열은 DOM으로 만들지 않고 원소 단위로 스트리밍해 바로 턴으로 추가합니다.
+    bool LoadJsonSnapshot(const std::string& path, Character& character, DialogueContext& context,
+                          std::string& playerName) {
         context.Clear();
-        if (data.contains("history") && data["history"].is_array()) {
-            for (const auto& entry : data["history"]) {
-                context.AddTurn(entry.value("speaker", "Unknown"), entry.value("text", ""));
+        // 역할이 없는 이전 형식의 턴은 캐릭터 이름을 알아야 하므로, 처음 나타난 이후로는 모아두었다가 처리합니다.
+        // (객체 키는 정렬되어 저장되므로 "history"가 "name"보다 먼저 나옵니다.)
+        std::vector<nlohmann::json> pending;
+        nlohmann::json data;
+        bool ok = JsonHelper::StreamFromFile(path, "history", data, [&](nlohmann::json&& entry) {
+            if (!entry.is_object()) return true;
+            if (pending.empty() && entry.contains("role")) {
+                AddTurnFromJson(entry, {}, context);
+            } else {
+                pending.push_back(std::move(entry));
             }
+            return true;
+        });
+        if (!ok || !data.is_object()) {
+            context.Clear();
+            return false;
+        }
+
+        character = data.get<Character>(); // 자동 변환 사용
+        for (const auto& entry : pending) {
+            AddTurnFromJson(entry, character.GetName(), context);
         }
+        playerName = data.value("playerName", "");
+        if (playerName.empty()) playerName = FindPlayerName(context);
+        return true;
+    }
+
+    // ---- 바이너리 세이브 (.sav) ----
+    // [매직 "ITSV"(4)][버전(2)][섹션 수(2)][섹션 테이블: ID(4) CRC(4) 오프셋(8) 크기(8) × N][섹션 본문...]
+    // 캐릭터 섹션: 캐릭터 상태 + 플레이어 이름 (MessagePack)
+    // 히스토리 섹션: [턴 수(4)][턴 배열 (MessagePack)]
+    // 청크 히스토리 섹션: [턴 수(4)][청크 수(4)][청크 참조: 해시(8) CRC(4) 크기(4) × N]
+    //   청크를 이어 붙인 내용은 [턴 길이(4)][턴 (MessagePack)]의 반복이며, 청크 자체는 세이브 간에 공유됩니다.
+    constexpr char kBinaryMagic[4] = {'I', 'T', 'S', 'V'};
+    constexpr std::uint16_t kBinaryVersion = 1;
+    constexpr std::uint32_t kSectionCharacter = 1;
+    constexpr std::uint32_t kSectionHistory = 2;
+    constexpr std::uint32_t kSectionHistoryChunks = 3;
+    constexpr std::size_t kChunkRefSize = 16;
+    constexpr std::size_t kBinaryHeaderSize = 8;
+    constexpr std::size_t kSectionEntrySize = 24;
+
+    struct SectionEntry {
+        std::uint32_t id = 0;
+        std::uint32_t crc = 0;
+        std::uint64_t offset = 0;
+        std::uint64_t size = 0;
+    };
+
+    template <typename T>
+    void PutRaw(std::string& out, T value) {
+        out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    T TakeRaw(const char* in) {
+        T value;
+        std::memcpy(&value, in, sizeof(T));
+        return value;
+    }
+
+    // 턴을 하나씩 길이와 함께 직렬화합니다. 이미 저장된 턴의 바이트는 세대가 바뀌어도 같습니다.
+    std::string SerializeTurnStream(const DialogueContext& context) {
+        std::string stream;
+        context.ForEachTurn(0, context.Size(), [&](const TurnView& turn) {
+            std::vector<std::uint8_t> bytes = nlohmann::json::to_msgpack(TurnToJson(turn));
+            PutRaw(stream, static_cast<std::uint32_t>(bytes.size()));
+            stream.append(bytes.begin(), bytes.end());
+            return true;
+        });
+        return stream;
+    }
+
+    bool BuildBinarySave(const Character& character, const DialogueContext& context, const std::string& playerName,
+                         ChunkStore* chunks, std::string& out) {
+        nlohmann::json meta = character;
+        meta["playerName"] = playerName;
+        std::vector<std::uint8_t> characterBytes = nlohmann::json::to_msgpack(meta);
+
+        // 청크 저장소가 있으면 히스토리 본문은 청크로 기록하고 참조 목록만 섹션에 담습니다.
+        // 턴 수는 직렬화로 미뤄 둔 기록까지 복원한 뒤에 셉니다.
+        std::string history;
+        std::uint32_t historyId = kSectionHistory;
+        if (chunks) {
+            std::string stream = SerializeTurnStream(context);
+            std::vector<ChunkRef> refs;
+            if (!chunks->Put(stream, refs)) return false;
+            PutRaw(history, static_cast<std::uint32_t>(context.Size()));
+            PutRaw(history, static_cast<std::uint32_t>(refs.size()));
+            for (const ChunkRef& ref : refs) {
+                PutRaw(history, ref.hash);
+                PutRaw(history, ref.crc);
+                PutRaw(history, ref.size);
+            }
+            historyId = kSectionHistoryChunks;
+        } else {
+            std::vector<std::uint8_t> historyBytes = nlohmann::json::to_msgpack(SerializeHistory(context));
+            PutRaw(history, static_cast<std::uint32_t>(context.Size()));
+            history.append(historyBytes.begin(), historyBytes.end());
+        }
+
+        std::string_view sections[] = {
+            {reinterpret_cast<const char*>(characterBytes.data()), characterBytes.size()},
+            history
+        };
+        const std::uint32_t ids[] = {kSectionCharacter, historyId};
+        constexpr std::uint16_t count = 2;
+
+        out.clear();
+        out.reserve(kBinaryHeaderSize + count * kSectionEntrySize + sections[0].size() + sections[1].size());
+        out.append(kBinaryMagic, sizeof(kBinaryMagic));
+        PutRaw(out, kBinaryVersion);
+        PutRaw(out, count);
+
+        std::uint64_t offset = kBinaryHeaderSize + count * kSectionEntrySize;
+        for (std::uint16_t i = 0; i < count; ++i) {
+            PutRaw(out, ids[i]);
+            PutRaw(out, FileIO::Crc32(sections[i]));
+            PutRaw(out, offset);
+            PutRaw(out, static_cast<std::uint64_t>(sections[i].size()));
+            offset += sections[i].size();
+        }
+        for (const auto& section : sections) {
+            out.append(section.data(), section.size());
+        }
+        return true;
+    }
+
+    // 헤더와 섹션 테이블을 해석합니다. (매핑된 파일에서 필요한 페이지만 읽힙니다)
+    bool ReadBinaryHeader(std::string_view file, std::vector<SectionEntry>& sections) {
+        if (file.size() < kBinaryHeaderSize || std::memcmp(file.data(), kBinaryMagic, sizeof(kBinaryMagic)) != 0) {
+            return false;
+        }
+        if (TakeRaw<std::uint16_t>(file.data() + 4) != kBinaryVersion) return false;
+        auto count = TakeRaw<std::uint16_t>(file.data() + 6);
+        if (file.size() < kBinaryHeaderSize + count * kSectionEntrySize) return false;
+
+        sections.resize(count);
+        for (std::uint16_t i = 0; i < count; ++i) {
+            const char* entry = file.data() + kBinaryHeaderSize + i * kSectionEntrySize;
+            sections[i].id = TakeRaw<std::uint32_t>(entry);
+            sections[i].crc = TakeRaw<std::uint32_t>(entry + 4);
+            sections[i].offset = TakeRaw<std::uint64_t>(entry + 8);
+            sections[i].size = TakeRaw<std::uint64_t>(entry + 16);
+        }
+        return true;
+    }
+
+    const SectionEntry* FindSection(const std::vector<SectionEntry>& sections, std::uint32_t id) {
+        for (const auto& section : sections) {
+            if (section.id == id) return &section;
+        }
+        return nullptr;
+    }
+
+    // 섹션 본문을 복사 없이 가리키는 뷰를 돌려줍니다. 범위를 벗어나거나 체크섬이 맞지 않으면 false를 반환합니다.
+    bool ReadSection(std::string_view file, const SectionEntry& entry, std::string_view& out) {
+        if (entry.offset > file.size() || entry.size > file.size() - entry.offset) return false;
+        out = file.substr(static_cast<std::size_t>(entry.offset), static_cast<std::size_t>(entry.size));
+        return FileIO::Crc32(out) == entry.crc;
+    }
+
+    // 저널 한 줄: "<crc32 8자리> <json>"
+    void AppendJournalRecord(std::string& batch, const nlohmann::json& record) {
+        FileIO::AppendChecksummedLine(batch, record.dump());
+    }
+
+    // 저널 한 줄을 검증하고 파싱합니다. 체크섬이 맞지 않거나 잘린 줄이면 false를 반환합니다.
+    bool ParseJournalRecord(const std::string& line, nlohmann::json& record) {
+        std::string_view body;
+        if (!FileIO::ParseChecksummedLine(line, body)) return false;
+        record = nlohmann::json::parse(body.begin(), body.end(), nullptr, false);
+        return !record.is_discarded();
+    }
+
+    bool IsBinarySave(const std::string& name) {
+        return std::filesystem::path(name).extension() == ".sav";
+    }
+
+    std::int64_t ToUnixSeconds(std::chrono::system_clock::time_point time) {
+        return std::chrono::duration_cast<std::chrono::seconds>(time.time_since_epoch()).count();
+    }
+
+    // 파일 수정 시각을 유닉스 시간으로 변환합니다. (C++17에는 clock_cast가 없으므로 현재 시각 기준으로 환산)
+    std::int64_t LastWriteSeconds(const std::filesystem::path& path) {
+        std::error_code ec;
+        auto written = std::filesystem::last_write_time(path, ec);
+        if (ec) return 0;
+        auto now = std::filesystem::file_time_type::clock::now();
+        return ToUnixSeconds(std::chrono::system_clock::now() +
+                             std::chrono::duration_cast<std::chrono::system_clock::duration>(written - now));
+    }
+
+    std::string MakeTimestampName() {
+        auto now = std::chrono::system_clock::now();
+        std::time_t t = std::chrono::system_clock::to_time_t(now);
+        std::tm tm{};
+#ifdef _WIN32
+        localtime_s(&tm, &t);
+#else
+        localtime_r(&t, &tm);
+#endif
+        std::ostringstream ts;
+        ts << std::put_time(&tm, "%Y%m%d_%H%M%S");
+        return ts.str();
+    }
+
+    // 청크 저장소는 세이브 디렉토리의 `chunks/` 아래에 있습니다.
+    std::string ChunkDirectoryFor(const std::string& savePath) {
+        return (std::filesystem::path(savePath).parent_path() / "chunks").string();
+    }
+
+    bool WriteSnapshot(const std::string& path, const Character& character, const DialogueContext& context,
+                       const std::string& playerName, ChunkStore* chunks) {
+        if (IsBinarySave(path)) {
+            std::string bytes;
+            return BuildBinarySave(character, context, playerName, chunks, bytes) && FileIO::WriteAtomic(path, bytes);
+        }
+        return JsonHelper::SaveToFile(path, Serialize(character, context, playerName));
+    }
+
+    // 청크 히스토리 섹션의 참조 목록을 `refs` 뒤에 덧붙입니다. 목록이 잘렸으면 false를 반환합니다.
+    bool ParseChunkRefs(std::string_view section, std::vector<ChunkRef>& refs) {
+        constexpr std::size_t kPrefix = 2 * sizeof(std::uint32_t);
+        if (section.size() < kPrefix) return false;
+        auto chunkCount = TakeRaw<std::uint32_t>(section.data() + sizeof(std::uint32_t));
+        if ((section.size() - kPrefix) / kChunkRefSize < chunkCount) {
+            std::cerr << "[SaveSystem] 청크 참조 목록이 잘렸습니다.\n";
+            return false;
+        }
+
+        refs.reserve(refs.size() + chunkCount);
+        for (std::uint32_t i = 0; i < chunkCount; ++i) {
+            const char* raw = section.data() + kPrefix + i * kChunkRefSize;
+            ChunkRef ref;
+            ref.hash = TakeRaw<std::uint64_t>(raw);
+            ref.crc = TakeRaw<std::uint32_t>(raw + 8);
+            ref.size = TakeRaw<std::uint32_t>(raw + 12);
+            refs.push_back(ref);
+        }
+        return true;
+    }
+
+    // 바이너리 세이브가 가리키는 청크 참조를 `refs` 뒤에 덧붙입니다. (청크를 쓰지 않는 세이브는 그대로 true)
+    bool ReadChunkRefs(const std::string& path, std::vector<ChunkRef>& refs) {
+        MappedFile file;
+        std::vector<SectionEntry> sections;
+        if (!file.Open(path) || !ReadBinaryHeader(file.View(), sections)) return false;
+        const SectionEntry* historySection = FindSection(sections, kSectionHistoryChunks);
+        if (!historySection) return true;
+        std::string_view data;
+        return ReadSection(file.View(), *historySection, data) && ParseChunkRefs(data, refs);
+    }
+
+    // 청크 히스토리 섹션의 참조를 따라 청크를 모아 턴을 복원합니다.
+    void RestoreChunkedHistory(std::string_view section, const std::string& chunkDirectory,
+                               const std::string& characterName, DialogueContext& context) {
+        std::vector<ChunkRef> refs;
+        if (!ParseChunkRefs(section, refs)) return;
+
+        std::string stream;
+        if (!ChunkStore(chunkDirectory, false).Get(refs, stream)) return;
+
+        std::size_t pos = 0;
+        while (pos + sizeof(std::uint32_t) <= stream.size()) {
+            auto length = TakeRaw<std::uint32_t>(stream.data() + pos);
+            pos += sizeof(std::uint32_t);
+            if (pos + length > stream.size()) break;
+            nlohmann::json turn = nlohmann::json::from_msgpack(stream.begin() + pos, stream.begin() + pos + length, true, false);
+            pos += length;
+            if (turn.is_object()) AddTurnFromJson(turn, characterName, context);
+        }
+    }
+
+    // 바이너리 세이브를 읽습니다. 캐릭터 섹션만 즉시 디코딩하고 히스토리는 지연 복원으로 등록합니다.
+    bool LoadBinarySnapshot(const std::string& path, nlohmann::json& state, DialogueContext& context,
+                            std::size_t& turnCount) {
+        MappedFile file;
+        std::vector<SectionEntry> sections;
+        if (!file.Open(path) || !ReadBinaryHeader(file.View(), sections)) {
+            std::cerr << "[SaveSystem] 바이너리 세이브 헤더가 올바르지 않습니다: " << path << '\n';
+            return false;
+        }
+
+        const SectionEntry* characterSection = FindSection(sections, kSectionCharacter);
+        const SectionEntry* historySection = FindSection(sections, kSectionHistoryChunks);
+        bool chunked = historySection != nullptr;
+        if (!chunked) historySection = FindSection(sections, kSectionHistory);
+        std::string_view bytes;
+        if (!characterSection || !ReadSection(file.View(), *characterSection, bytes)) {
+            std::cerr << "[SaveSystem] 캐릭터 섹션이 손상되었습니다: " << path << '\n';
+            return false;
+        }
+        state = nlohmann::json::from_msgpack(bytes.begin(), bytes.end(), true, false);
+        if (state.is_discarded() || !state.is_object()) return false;
+
+        context.Clear();
+        turnCount = 0;
+        if (!historySection || historySection->size < sizeof(std::uint32_t)) {
+            return true;
+        }
+
+        // 턴 수(앞 4바이트)만 읽어두고, 본문은 처음 필요할 때 디코딩합니다.
+        if (historySection->offset + sizeof(std::uint32_t) > file.View().size()) return false;
+        turnCount = TakeRaw<std::uint32_t>(file.View().data() + historySection->offset);
+
+        SectionEntry entry = *historySection;
+        std::string characterName = state.value("name", "");
+        context.Defer([path, entry, chunked, characterName](DialogueContext& ctx) {
+            MappedFile file;
+            std::string_view data;
+            if (!file.Open(path) || !ReadSection(file.View(), entry, data)) {
+                std::cerr << "[SaveSystem] 히스토리 섹션이 손상되었습니다: " << path << '\n';
+                return;
+            }
+            if (chunked) {
+                RestoreChunkedHistory(data, ChunkDirectoryFor(path), characterName, ctx);
+                return;
+            }
+            nlohmann::json history = nlohmann::json::from_msgpack(data.begin() + sizeof(std::uint32_t), data.end(), true, false);
+            if (!history.is_array()) return;
+            for (const auto& turn : history) {
+                AddTurnFromJson(turn, characterName, ctx);
+            }
+        }, turnCount);
+        return true;
+    }
+}
+
+SaveSystem::SaveSystem(const Config& config)
+    : directory_(config.GetSavesDir()),
+      journalMode_(config.GetSaveMode() == "journal"),
+      binaryFormat_(config.GetSaveFormat() == "binary"),
+      compactEvery_(static_cast<std::size_t>(std::max(1, config.GetJournalCompactEvery()))),
+      journaledTurns_(0),
+      journalRecords_(0),
+      catalog_(config.GetSavesDir()),
+      catalogReady_(false) {
+    // 바이너리 세이브의 대화 기록은 세대 간에 공유되는 청크로 저장합니다.
+    if (binaryFormat_) {
+        chunks_ = std::make_unique<ChunkStore>((std::filesystem::path(directory_) / "chunks").string(),
+                                               config.GetSaveCompression() == "deflate");
+    }
+}
+
+SaveSystem::~SaveSystem() = default;
+
+void SaveSystem::BeginPlaythrough() {
+    playthrough_.clear();
+    journaledTurns_ = 0;
+    journalRecords_ = 0;
+    lastState_ = nullptr;
+}
+
+std::string SaveSystem::Save(const Character& character, const DialogueContext& context, const std::string& playerName) {
+    std::string fname = journalMode_ ? SaveJournal(character, context, playerName) : SaveNew(character, context, playerName);
+    if (!fname.empty()) {
+        RecordSave(fname, character, context, playerName);
     }
+    return fname;
+}
+
+std::size_t SaveSystem::SaveCount() {
+    EnsureCatalog();
+    return catalog_.Size();
+}
+
+std::vector<SaveCatalogEntry> SaveSystem::ListSaves(std::size_t offset, std::size_t limit) {
+    EnsureCatalog();
+    return catalog_.Page(offset, limit);
 }
 
-SaveSystem::SaveSystem(std::string directory) : directory_(std::move(directory)) {}
+void SaveSystem::EnsureCatalog() {
+    if (catalogReady_) return;
+    catalogReady_ = true;
+    if (catalog_.Load()) {
+        if (catalog_.TakePruned() > 0) CollectChunks();
+        return;
+    }
 
-std::vector<std::string> SaveSystem::ListSaveFiles() const {
+    // 색인이 없는 이전 세이브 디렉토리: 한 번만 모든 세이브를 읽어 색인을 만듭니다.
     namespace fs = std::filesystem;
-    std::vector<std::string> files;
-    if (!fs::exists(directory_)) {
-        return files;
+    std::error_code ec;
+    if (!fs::exists(directory_, ec)) return;
+
+    std::vector<SaveCatalogEntry> entries;
+    for (const auto& file : fs::directory_iterator(directory_, ec)) {
+        auto extension = file.path().extension();
+        if (!file.is_regular_file() || (extension != ".json" && extension != ".sav")) continue;
+        SaveCatalogEntry entry;
+        if (ReadSummary(file.path().filename().string(), entry)) {
+            entries.push_back(std::move(entry));
+        }
+    }
+    std::sort(entries.begin(), entries.end(), [](const SaveCatalogEntry& a, const SaveCatalogEntry& b) {
+        return a.savedAt != b.savedAt ? a.savedAt < b.savedAt : a.file < b.file;
+    });
+    catalog_.UpsertAll(entries);
+}
+
+bool SaveSystem::ReadSummary(const std::string& filename, SaveCatalogEntry& entry) const {
+    nlohmann::json data;
+    std::size_t turnCount = 0;
+    if (IsBinarySave(filename)) {
+        // 히스토리는 지연 복원으로만 등록되고 실행되지 않으므로 캐릭터 섹션만 읽습니다.
+        DialogueContext scratch;
+        if (!LoadBinarySnapshot(BuildPathFromName(filename), data, scratch, turnCount)) return false;
+    } else {
+        // 대화 기록은 개수만 셉니다.
+        bool ok = JsonHelper::StreamFromFile(BuildPathFromName(filename), "history", data, [&](nlohmann::json&&) {
+            ++turnCount;
+            return true;
+        });
+        if (!ok || !data.is_object()) return false;
+        data.erase("history");
     }
-    for (const auto& entry : fs::directory_iterator(directory_)) {
-        if (entry.is_regular_file() && entry.path().extension() == ".json") {
-            files.push_back(entry.path().filename().string());
+
+    // 저널의 턴 수와 마지막 상태까지 반영합니다.
+    std::string journalPath = BuildJournalPath(filename);
+    std::ifstream journal(journalPath);
+    std::string line;
+    while (journal.is_open() && std::getline(journal, line)) {
+        if (line.empty()) continue;
+        nlohmann::json record;
+        if (!ParseJournalRecord(line, record)) break;
+        std::string type = record.value("t", "");
+        if (type == "turn") {
+            ++turnCount;
+        } else if (type == "state" && record.contains("state")) {
+            data.update(record["state"]);
         }
     }
-    std::sort(files.begin(), files.end(), std::greater<>());
-    return files;
+    bool journaled = journal.is_open();
+    journal.close();
+
+    entry.file = filename;
+    entry.character = data.value("name", "Unknown");
+    entry.playerName = data.value("playerName", "");
+    entry.affection = data.value("affection", 0);
+    entry.stage = data.value("relationshipStage", 0);
+    entry.turns = turnCount;
+    entry.savedAt = LastWriteSeconds(journaled ? journalPath : BuildPathFromName(filename));
+    return true;
 }
 
-std::string SaveSystem::SaveNew(const Character& character, const DialogueContext& context) const {
+void SaveSystem::RecordSave(const std::string& filename, const Character& character,
+                            const DialogueContext& context, const std::string& playerName) {
+    EnsureCatalog();
+    SaveCatalogEntry entry;
+    entry.file = filename;
+    entry.character = character.GetName();
+    entry.playerName = playerName;
+    entry.affection = character.GetAffection();
+    entry.stage = character.GetRelationshipStage();
+    entry.turns = context.Size();
+    entry.savedAt = ToUnixSeconds(std::chrono::system_clock::now());
+    if (!catalog_.Upsert(entry)) {
+        std::cerr << "[SaveSystem] 세이브 색인 갱신 실패: " << filename << '\n';
+    }
+    // 색인을 다시 쓰다가 게임 밖에서 지운 세이브를 발견했으면 그 청크도 정리합니다.
+    if (catalog_.TakePruned() > 0) CollectChunks();
+}
+
+std::string SaveSystem::SaveNew(const Character& character, const DialogueContext& context, const std::string& playerName) const {
     if (character.GetName().empty()) return {};
 
     namespace fs = std::filesystem;
     fs::create_directories(directory_);
 
-    auto now = std::chrono::system_clock::now();
-    std::time_t t = std::chrono::system_clock::to_time_t(now);
-    std::tm tm{};
-#ifdef _WIN32
-    localtime_s(&tm, &t);
-#else
-    localtime_r(&t, &tm);
-#endif
-    std::ostringstream ts;
-    ts << std::put_time(&tm, "%Y%m%d_%H%M%S");
-    std::string fname = ts.str() + ".json";
+    std::string fname = MakeTimestampName() + (binaryFormat_ ? ".sav" : ".json");
     fs::path path = fs::path(directory_) / fname;
 
-    nlohmann::json data = Serialize(character, context);
-    if (!JsonHelper::SaveToFile(path.string(), data)) {
+    if (!WriteSnapshot(path.string(), character, context, playerName, chunks_.get())) {
         return {};
     }
     return fname;
 }
 
-bool SaveSystem::LoadFromFile(const std::string& filename, Character& character, DialogueContext& context) const {
-    nlohmann::json data;
-    if (!JsonHelper::LoadFromFile(BuildPathFromName(filename), data)) {
+std::string SaveSystem::ExportJson(const Character& character, const DialogueContext& context, const std::string& playerName) {
+    if (character.GetName().empty()) return {};
+
+    namespace fs = std::filesystem;
+    fs::create_directories(directory_);
+
+    std::string fname = MakeTimestampName() + "_export.json";
+    fs::path path = fs::path(directory_) / fname;
+
+    if (!JsonHelper::SaveToFile(path.string(), Serialize(character, context, playerName))) {
+        return {};
+    }
+    RecordSave(fname, character, context, playerName);
+    return fname;
+}
+
+std::string SaveSystem::SaveJournal(const Character& character, const DialogueContext& context, const std::string& playerName) {
+    if (character.GetName().empty()) return {};
+
+    // 플레이의 첫 저장: 기본 스냅샷을 만들고 이후 저장은 저널에 이어 씁니다.
+    if (playthrough_.empty()) {
+        std::string fname = SaveNew(character, context, playerName);
+        if (fname.empty()) return {};
+        playthrough_ = fname;
+        journaledTurns_ = context.Size();
+        journalRecords_ = 0;
+        lastState_ = character;
+        return fname;
+    }
+
+    std::string journalPath = BuildJournalPath(playthrough_);
+
+    // 새 턴과 바뀐 상태 키만 JSON 한 줄씩 추가합니다.
+    std::string batch;
+    std::size_t records = 0;
+    context.ForEachTurn(journaledTurns_, context.Size(), [&](const TurnView& turn) {
+        nlohmann::json record = TurnToJson(turn);
+        record["t"] = "turn";
+        AppendJournalRecord(batch, record);
+        ++records;
+        return true;
+    });
+
+    nlohmann::json state = character;
+    nlohmann::json delta = nlohmann::json::object();
+    for (auto it = state.begin(); it != state.end(); ++it) {
+        if (!lastState_.is_object() || !lastState_.contains(it.key()) || lastState_[it.key()] != it.value()) {
+            delta[it.key()] = it.value();
+        }
+    }
+    if (!delta.empty()) {
+        AppendJournalRecord(batch, {{"t", "state"}, {"state", std::move(delta)}});
+        ++records;
+    }
+
+    // 한 번의 저장에서 생긴 레코드를 한꺼번에 쓰고 fsync도 한 번만 합니다.
+    if (!FileIO::AppendDurable(journalPath, batch)) {
+        std::cerr << "[SaveSystem] 저널 기록 실패: " << journalPath << '\n';
+        return {};
+    }
+
+    journaledTurns_ = context.Size();
+    journalRecords_ += records;
+    lastState_ = std::move(state);
+
+    if (journalRecords_ >= compactEvery_) {
+        Compact(character, context, playerName);
+    }
+    return playthrough_;
+}
+
+bool SaveSystem::Compact(const Character& character, const DialogueContext& context, const std::string& playerName) {
+    // 전체 상태로 기본 스냅샷을 다시 쓰고 저널을 비웁니다.
+    if (!WriteSnapshot(BuildPathFromName(playthrough_), character, context, playerName, chunks_.get())) {
+        return false;
+    }
+    std::error_code ec;
+    std::filesystem::remove(BuildJournalPath(playthrough_), ec);
+    journalRecords_ = 0;
+    // 스냅샷을 다시 쓰면서 밀려난 이전 세대의 청크를 정리합니다.
+    CollectChunks();
+    return true;
+}
+
+void SaveSystem::CollectChunks() {
+    if (!chunks_) return;
+
+    // 마크: 디스크에 남은 모든 바이너리 세이브(직전 세대 `.bak` 포함)가 가리키는 청크를 모읍니다.
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    std::vector<ChunkRef> live;
+    for (const auto& file : fs::directory_iterator(directory_, ec)) {
+        std::string name = file.path().filename().string();
+        bool manifest = IsBinarySave(name) || (file.path().extension() == ".bak" && IsBinarySave(file.path().stem().string()));
+        if (!file.is_regular_file() || !manifest) continue;
+        if (!ReadChunkRefs(file.path().string(), live)) {
+            // 읽지 못한 세이브가 가리키는 청크를 지우지 않도록 이번 정리는 건너뜁니다.
+            std::cerr << "[SaveSystem] 세이브를 읽을 수 없어 청크 정리를 건너뜁니다: " << name << '\n';
+            return;
+        }
+    }
+    if (ec) return;
+
+    // 스윕: 어느 세이브도 가리키지 않는 청크를 지웁니다.
+    std::size_t removed = chunks_->Collect(live);
+    if (removed > 0) {
+        std::cerr << "[SaveSystem] 쓰이지 않는 청크 " << removed << "개를 정리했습니다.\n";
+    }
+}
+
+bool SaveSystem::LoadFromFile(const std::string& filename, Character& character, DialogueContext& context, std::string& playerName) {
+    std::error_code ec;
+    if (!std::filesystem::exists(BuildPathFromName(filename), ec)) {
+        std::cerr << "[SaveSystem] 세이브 파일이 없어 색인에서 뺍니다: " << filename << '\n';
+        EnsureCatalog();
+        catalog_.Remove(filename);
+        CollectChunks();
         return false;
     }
-    Deserialize(data, character, context);
+
+    nlohmann::json data;
+    std::size_t turnCount = 0;
+    if (IsBinarySave(filename)) {
+        if (!LoadBinarySnapshot(BuildPathFromName(filename), data, context, turnCount)) {
+            return false;
+        }
+        character = data.get<Character>();
+        playerName = data.value("playerName", "");
+    } else {
+        if (!LoadJsonSnapshot(BuildPathFromName(filename), character, context, playerName)) {
+            return false;
+        }
+        data = character;
+        turnCount = context.Size();
+    }
+
+    // 저널이 있으면 기본 스냅샷 위에 순서대로 재생합니다.
+    // 턴 레코드는 기본 히스토리 뒤에 이어지도록 지연 복원으로 등록합니다.
+    std::size_t records = 0;
+    bool corrupted = false;
+    std::ifstream journal(BuildJournalPath(filename));
+    if (journal.is_open()) {
+        std::string line;
+        bool stateChanged = false;
+        std::vector<nlohmann::json> turns;
+        while (std::getline(journal, line)) {
+            if (line.empty()) continue;
+            nlohmann::json record;
+            if (!ParseJournalRecord(line, record)) {
+                // 기록 도중 중단되었거나 손상된 줄부터는 버립니다.
+                std::cerr << "[SaveSystem] 손상된 저널 레코드를 건너뜁니다: " << filename << '\n';
+                corrupted = true;
+                break;
+            }
+            std::string type = record.value("t", "");
+            if (type == "turn") {
+                turns.push_back(std::move(record));
+            } else if (type == "state" && record.contains("state")) {
+                data.update(record["state"]);
+                stateChanged = true;
+            }
+            ++records;
+        }
+        if (stateChanged) {
+            character = data.get<Character>();
+        }
+        if (!turns.empty()) {
+            turnCount += turns.size();
+            std::size_t deferred = turns.size();
+            context.Defer([turns = std::move(turns), name = character.GetName()](DialogueContext& ctx) {
+                for (const auto& turn : turns) {
+                    AddTurnFromJson(turn, name, ctx);
+                }
+            }, deferred);
+        }
+    }
+
+    journal.close();
+
+    playthrough_ = filename;
+    journaledTurns_ = turnCount;
+    journalRecords_ = records;
+    lastState_ = character;
+
+    // 손상된 꼬리 뒤에 새 레코드가 붙지 않도록 복구된 상태로 바로 압축합니다.
+    if (corrupted && journalMode_) {
+        Compact(character, context, playerName);
+    }
     return true;
 }
 
+std::string SaveSystem::BuildJournalPath(const std::string& name) const {
+    namespace fs = std::filesystem;
+    fs::path path = fs::path(directory_) / name;
+    path.replace_extension(".journal");
+    return path.string();
+}
+
 std::string SaveSystem::BuildPathFromName(const std::string& name) const {
     namespace fs = std::filesystem;
     fs::path path = fs::path(directory_) / name;
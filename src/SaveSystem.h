@@ -1,29 +1,83 @@
 #pragma once
 
+#include <memory>
 #include <string>
 #include <vector>
 
+#include <nlohmann/json.hpp>
+
+#include "SaveCatalog.h"
+
 class Character;
+class ChunkStore;
+class Config;
 struct DialogueContext;
 
 /**
- * 게임 상태를 JSON 형식으로 직렬화(저장)하고 복원(로드)합니다.
+ * 게임 상태를 JSON 또는 바이너리 형식으로 직렬화(저장)하고 복원(로드)합니다.
+ *
+ * 저널 모드에서는 플레이마다 기본 스냅샷(`<이름>.json` 또는 `<이름>.sav`) 하나를 만들고,
+ * 이후 저장은 새 턴과 상태 변화만 `<이름>.journal`에 추가합니다.
+ * 바이너리 스냅샷은 캐릭터 섹션만 즉시 읽고, 대화 기록은 처음 필요할 때 디코딩합니다.
+ * 바이너리 스냅샷의 대화 기록은 `chunks/`의 내용 기반 청크로 저장되어, 세대 간에 겹치는 부분은 한 번만 기록됩니다.
+ * 세이브가 지워지거나 압축되면 남은 세이브가 가리키지 않는 청크를 정리합니다.
+ * 저장할 때마다 `catalog.idx`에 요약을 기록하므로 로드 메뉴는 세이브 파일을 열지 않습니다.
  */
 class SaveSystem {
 public:
-    // 지정된 디렉토리를 루트로 하는 저장 시스템을 생성합니다.
-    explicit SaveSystem(std::string directory);
+    // 설정의 세이브 디렉토리와 저장 방식을 사용하는 저장 시스템을 생성합니다.
+    explicit SaveSystem(const Config& config);
+    ~SaveSystem();
+
+    // 새 플레이를 시작합니다. 저널 모드에서는 다음 저장 시 새 기본 스냅샷을 만듭니다.
+    void BeginPlaythrough();
+
+    // 설정된 저장 방식으로 현재 상태를 저장하고 파일 이름을 반환합니다. (실패 시 빈 문자열)
+    std::string Save(const Character& character, const DialogueContext& context, const std::string& playerName);
 
-    // 현재 상태를 새로운 파일로 저장합니다. (타임스탬프)
-    std::string SaveNew(const Character& character, const DialogueContext& context) const;
+    // 현재 상태를 설정된 형식의 새 파일로 저장합니다. (타임스탬프)
+    std::string SaveNew(const Character& character, const DialogueContext& context, const std::string& playerName) const;
 
-    // 특정 파일을 로드합니다.
-    bool LoadFromFile(const std::string& filename, Character& character, DialogueContext& context) const;
+    // 형식 설정과 관계없이 현재 상태를 텍스트 JSON 파일로 내보냅니다. (모딩용)
+    std::string ExportJson(const Character& character, const DialogueContext& context, const std::string& playerName);
 
-    // 저장된 파일 목록을 반환합니다.
-    std::vector<std::string> ListSaveFiles() const;
+    // 특정 파일을 로드합니다. 같은 이름의 저널이 있으면 이어서 재생합니다.
+    // 파일이 없으면(게임 밖에서 지움) 색인에서 빼고 false를 반환합니다.
+    bool LoadFromFile(const std::string& filename, Character& character, DialogueContext& context, std::string& playerName);
+
+    // 색인된 세이브 수를 반환합니다.
+    std::size_t SaveCount();
+
+    // 최신 저장 순으로 [offset, offset + limit) 구간의 세이브 요약을 반환합니다.
+    std::vector<SaveCatalogEntry> ListSaves(std::size_t offset, std::size_t limit);
 
 private:
-    std::string directory_;
+    std::string SaveJournal(const Character& character, const DialogueContext& context, const std::string& playerName);
+    bool Compact(const Character& character, const DialogueContext& context, const std::string& playerName);
     std::string BuildPathFromName(const std::string& name) const;
+    std::string BuildJournalPath(const std::string& name) const;
+
+    // 색인을 읽고, 없으면 세이브 디렉토리를 한 번 훑어 다시 만듭니다.
+    void EnsureCatalog();
+    bool ReadSummary(const std::string& filename, SaveCatalogEntry& entry) const;
+    void RecordSave(const std::string& filename, const Character& character,
+                    const DialogueContext& context, const std::string& playerName);
+
+    // 남은 세이브가 가리키지 않는 청크를 지웁니다. (세이브가 지워지거나 압축된 뒤)
+    void CollectChunks();
+
+    std::string directory_;
+    bool journalMode_;
+    bool binaryFormat_;
+    std::size_t compactEvery_;
+
+    // 저널 모드에서 현재 플레이의 진행 상태
+    std::string playthrough_;
+    std::size_t journaledTurns_;
+    std::size_t journalRecords_;
+    nlohmann::json lastState_;
+
+    std::unique_ptr<ChunkStore> chunks_;  // 바이너리 형식에서만 사용
+    SaveCatalog catalog_;
+    bool catalogReady_;
 };
@@ -0,0 +1,76 @@
+#include "SaveWorker.h"
+
+#include "SaveSystem.h"
+
+SaveWorker::SaveWorker(SaveSystem& saveSystem)
+    : saveSystem_(saveSystem),
+      busy_(false),
+      stopping_(false),
+      thread_(&SaveWorker::Run, this) {}
+
+SaveWorker::~SaveWorker() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    // 남은 요청까지 저장한 뒤 종료합니다.
+    thread_.join();
+}
+
+void SaveWorker::Submit(const Character& character, const DialogueContext& context, const std::string& playerName) {
+    auto job = std::make_unique<Job>(Job{character, context, playerName});
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (pending_) {
+            // 아직 시작하지 않은 요청은 최신 스냅샷으로 대체합니다.
+            job->coalesced += pending_->coalesced;
+        }
+        pending_ = std::move(job);
+    }
+    cv_.notify_all();
+}
+
+std::vector<SaveResult> SaveWorker::PollCompleted() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<SaveResult> results;
+    results.swap(completed_);
+    return results;
+}
+
+void SaveWorker::WaitIdle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return !pending_ && !busy_; });
+}
+
+void SaveWorker::SetOnComplete(std::function<void()> onComplete) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    onComplete_ = std::move(onComplete);
+}
+
+void SaveWorker::Run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        cv_.wait(lock, [this] { return pending_ || stopping_; });
+        if (!pending_) break;  // 종료 요청이고 남은 작업 없음
+
+        std::unique_ptr<Job> job = std::move(pending_);
+        busy_ = true;
+        lock.unlock();
+
+        SaveResult result;
+        result.filename = saveSystem_.Save(job->character, job->context, job->playerName);
+        result.ok = !result.filename.empty();
+        result.coalesced = job->coalesced;
+        job.reset();  // 스냅샷이 공유하던 저장소를 여기서 놓아줍니다.
+
+        lock.lock();
+        busy_ = false;
+        completed_.push_back(std::move(result));
+        auto onComplete = onComplete_;
+        lock.unlock();
+        cv_.notify_all();
+        if (onComplete) onComplete();
+        lock.lock();
+    }
+}
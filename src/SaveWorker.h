@@ -0,0 +1,72 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Character.h"
+#include "DialogueManager.h"
+
+class SaveSystem;
+
+/**
+ * 완료된 저장 요청의 결과입니다.
+ */
+struct SaveResult {
+    bool ok = false;
+    std::string filename;
+    int coalesced = 1;  // 이 저장 하나로 합쳐진 요청 수
+};
+
+/**
+ * 직렬화와 디스크 I/O를 별도 스레드에서 처리하는 저장 작업자입니다.
+ * 게임 스레드는 캐릭터와 대화 기록의 스냅샷만 만들어 넘기며, 스냅샷은 O(1) copy-on-write 복사입니다.
+ * 아직 시작되지 않은 요청이 있을 때 새 요청이 오면 최신 스냅샷 하나로 합칩니다.
+ */
+class SaveWorker {
+public:
+    explicit SaveWorker(SaveSystem& saveSystem);
+    ~SaveWorker();
+
+    SaveWorker(const SaveWorker&) = delete;
+    SaveWorker& operator=(const SaveWorker&) = delete;
+
+    // 저장을 요청합니다. 바로 반환하며, 결과는 PollCompleted()로 받습니다.
+    void Submit(const Character& character, const DialogueContext& context, const std::string& playerName);
+
+    // 완료된 저장 결과를 꺼냅니다. (게임 스레드에서 호출)
+    std::vector<SaveResult> PollCompleted();
+
+    // 대기 중이거나 진행 중인 저장이 모두 끝날 때까지 기다립니다.
+    // SaveSystem을 게임 스레드에서 직접 사용하기 전에 호출해야 합니다.
+    void WaitIdle();
+
+    // 저장이 끝날 때마다 작업자 스레드에서 호출할 알림 함수를 설정합니다.
+    void SetOnComplete(std::function<void()> onComplete);
+
+private:
+    struct Job {
+        Character character;
+        DialogueContext context;
+        std::string playerName;
+        int coalesced = 1;
+    };
+
+    void Run();
+
+    SaveSystem& saveSystem_;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::unique_ptr<Job> pending_;
+    bool busy_;
+    bool stopping_;
+    std::vector<SaveResult> completed_;
+    std::function<void()> onComplete_;
+
+    std::thread thread_;
+};
@@ -0,0 +1,115 @@
+#include "ScreenBuffer.h"
+
+#include <algorithm>
+
+#include "TextLayout.h"
+
+namespace {
+void EncodeUtf8(char32_t cp, std::string& out) {
+    if (cp < 0x80) {
+        out += static_cast<char>(cp);
+    } else if (cp < 0x800) {
+        out += static_cast<char>(0xC0 | (cp >> 6));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        out += static_cast<char>(0xE0 | (cp >> 12));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (cp >> 18));
+        out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+}
+
+void AppendStyle(std::uint8_t style, std::string& out) {
+    out += "\x1b[0";
+    if (style & ScreenBuffer::kBold) out += ";1";
+    if (style & ScreenBuffer::kReverse) out += ";7";
+    out += 'm';
+}
+}  // 익명 네임스페이스 종료
+
+void ScreenBuffer::Resize(int columns, int rows) {
+    columns = std::max(columns, 1);
+    rows = std::max(rows, 1);
+    if (columns == columns_ && rows == rows_) return;
+    columns_ = columns;
+    rows_ = rows;
+    back_.assign(static_cast<std::size_t>(columns_) * rows_, Cell{});
+    front_ = back_;
+    valid_ = false;
+}
+
+void ScreenBuffer::Clear() {
+    std::fill(back_.begin(), back_.end(), Cell{});
+}
+
+int ScreenBuffer::Put(int column, int row, std::string_view text, std::uint8_t style) {
+    if (row < 0 || row >= rows_ || column < 0) return 0;
+    int start = column;
+    for (std::size_t i = 0; i < text.size();) {
+        char32_t cp = TextLayout::Decode(text, i);
+        int width = TextLayout::Width(cp);
+        if (width == 0) continue;
+        if (column + width > columns_) break;
+
+        // 두 칸 글자의 절반을 덮어쓰면 남은 절반을 공백으로 지웁니다.
+        if (At(back_, column, row).glyph == 0 && column > 0) At(back_, column - 1, row) = Cell{};
+        int after = column + width;
+        if (after < columns_ && At(back_, after, row).glyph == 0) At(back_, after, row) = Cell{};
+
+        At(back_, column, row) = Cell{cp, style};
+        if (width == 2) At(back_, column + 1, row) = Cell{0, style};
+        column = after;
+    }
+    return column - start;
+}
+
+void ScreenBuffer::PutCentered(int row, std::string_view text, std::uint8_t style) {
+    Put(std::max(0, (columns_ - TextLayout::Width(text)) / 2), row, text, style);
+}
+
+std::string ScreenBuffer::Flush() {
+    std::string out;
+    if (!valid_) {
+        // 실제 화면(일부 줄만 맡았으면 그 줄들)을 지우고, 비어 있는 화면과 비교해 글자가 있는 칸만 그립니다.
+        out += "\x1b[0m";
+        if (originRow_ < 0) {
+            out += "\x1b[H\x1b[2J";
+        } else {
+            for (int row = 0; row < rows_; ++row) out += "\x1b[" + std::to_string(originRow_ + row + 1) + ";1H\x1b[2K";
+        }
+        std::fill(front_.begin(), front_.end(), Cell{});
+    }
+
+    const int firstRow = std::max(originRow_, 0) + 1;
+    std::uint8_t current = kPlain;
+    for (int row = 0; row < rows_; ++row) {
+        int lo = 0;
+        while (lo < columns_ && At(back_, lo, row) == At(front_, lo, row)) ++lo;
+        if (lo == columns_) continue;
+        int hi = columns_ - 1;
+        while (hi > lo && At(back_, hi, row) == At(front_, hi, row)) --hi;
+        // 두 칸 글자의 중간에서 시작하거나 끝나지 않도록 넓힙니다.
+        while (lo > 0 && At(back_, lo, row).glyph == 0) --lo;
+        if (hi + 1 < columns_ && At(back_, hi + 1, row).glyph == 0) ++hi;
+
+        out += "\x1b[" + std::to_string(firstRow + row) + ";" + std::to_string(lo + 1) + "H";
+        for (int column = lo; column <= hi; ++column) {
+            const Cell& cell = At(back_, column, row);
+            if (cell.glyph == 0) continue;
+            if (cell.style != current) {
+                AppendStyle(cell.style, out);
+                current = cell.style;
+            }
+            EncodeUtf8(cell.glyph, out);
+        }
+    }
+    if (current != kPlain) AppendStyle(kPlain, out);
+
+    front_ = back_;
+    valid_ = true;
+    return out;
+}
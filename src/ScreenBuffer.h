@@ -0,0 +1,66 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * 화면 한 장을 메모리에서 구성한 뒤, 직전에 내보낸 화면과 비교해 바뀐 칸만 출력 문자열로 만듭니다.
+ *
+ * 각 칸은 코드 포인트 하나와 스타일을 가지며, 한글처럼 두 칸을 차지하는 글자(TextLayout::Width)는
+ * 뒤 칸을 이어지는 칸(글자 0)으로 표시합니다. 행마다 처음과 마지막으로 달라진 칸 사이만 다시 씁니다.
+ * SetOrigin으로 화면의 일부 줄(상태 표시줄 등)만 맡을 수도 있습니다.
+ */
+class ScreenBuffer {
+public:
+    enum Style : std::uint8_t {
+        kPlain = 0,
+        kBold = 1 << 0,
+        kReverse = 1 << 1,
+    };
+
+    // 화면 크기를 바꿉니다. 크기가 달라지면 다음 Flush는 전체를 다시 그립니다.
+    void Resize(int columns, int rows);
+
+    // 버퍼를 화면 전체가 아니라 `row`번째 줄(0부터)부터 Rows()줄만 맡는 영역으로 씁니다.
+    // 다시 그릴 때는 화면 전체 대신 맡은 줄들만 지웁니다.
+    void SetOrigin(int row) { originRow_ = std::max(row, 0); }
+
+    // 그릴 화면(뒤 버퍼)을 공백으로 채웁니다.
+    void Clear();
+
+    // (column, row)부터 UTF-8 텍스트를 씁니다. 화면 밖으로 나가는 부분은 잘립니다. 쓴 칸 수를 반환합니다.
+    int Put(int column, int row, std::string_view text, std::uint8_t style = kPlain);
+
+    // 행의 가운데에 텍스트를 씁니다.
+    void PutCentered(int row, std::string_view text, std::uint8_t style = kPlain);
+
+    // 직전 Flush 이후 바뀐 부분만 그리는 ANSI 시퀀스를 반환하고 현재 화면을 기준으로 삼습니다.
+    std::string Flush();
+
+    // 실제 화면이 다른 출력으로 바뀌었을 때 호출합니다. 다음 Flush는 전체를 다시 그립니다.
+    void Invalidate() { valid_ = false; }
+
+    int Columns() const { return columns_; }
+    int Rows() const { return rows_; }
+
+private:
+    struct Cell {
+        char32_t glyph = U' ';  // 0이면 앞 글자에 이어지는 칸
+        std::uint8_t style = kPlain;
+
+        bool operator==(const Cell& other) const { return glyph == other.glyph && style == other.style; }
+        bool operator!=(const Cell& other) const { return !(*this == other); }
+    };
+
+    Cell& At(std::vector<Cell>& cells, int column, int row) { return cells[static_cast<std::size_t>(row) * columns_ + column]; }
+
+    int columns_ = 0;
+    int rows_ = 0;
+    int originRow_ = -1;  // 음수면 화면 전체
+    bool valid_ = false;      // front_가 실제 화면과 같은지
+    std::vector<Cell> back_;  // 그리는 중인 화면
+    std::vector<Cell> front_; // 마지막으로 내보낸 화면
+};
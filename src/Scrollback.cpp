@@ -0,0 +1,72 @@
+#include "Scrollback.h"
+
+#include <algorithm>
+
+Scrollback::Scrollback(LayoutCache& layouts, std::size_t capacity)
+    : layouts_(layouts), slots_(std::max<std::size_t>(capacity, 1)) {}
+
+void Scrollback::Reset(int width, std::size_t turn) {
+    head_ = 0;
+    count_ = 0;
+    begin_ = 0;
+    firstTurn_ = turn;
+    endTurn_ = turn;
+    width_ = std::max(width, 2);
+}
+
+void Scrollback::AppendTurn(std::string_view text) {
+    Insert(layouts_.Get(endTurn_, width_, text), endTurn_, false);
+    ++endTurn_;
+}
+
+void Scrollback::PrependTurn(std::string_view text) {
+    if (firstTurn_ == 0) return;
+    --firstTurn_;
+    Insert(layouts_.Get(firstTurn_, width_, text), firstTurn_, true);
+}
+
+void Scrollback::Insert(const LayoutCache::Lines& lines, std::size_t turn, bool prepend) {
+    const std::size_t total = lines->size();
+    const std::size_t keep = std::min(total, slots_.size());
+    if (prepend) {
+        while (count_ > 0 && count_ + keep > slots_.size()) DropBackTurn();
+        if (count_ == 0) endTurn_ = turn + 1;
+        for (std::size_t i = keep; i-- > 0;) {
+            head_ = (head_ + slots_.size() - 1) % slots_.size();
+            ++count_;
+            --begin_;
+            Slot(0) = Line{lines, static_cast<std::uint32_t>(i), turn};
+        }
+    } else {
+        while (count_ > 0 && count_ + keep > slots_.size()) DropFrontTurn();
+        if (count_ == 0) firstTurn_ = turn;
+        for (std::size_t i = total - keep; i < total; ++i) {
+            Slot(count_++) = Line{lines, static_cast<std::uint32_t>(i), turn};
+        }
+    }
+}
+
+const std::string& Scrollback::At(std::int64_t line) const {
+    const Line& slot = Slot(static_cast<std::size_t>(line - begin_));
+    return (*slot.lines)[slot.index];
+}
+
+std::size_t Scrollback::TurnAt(std::int64_t line) const {
+    return Slot(static_cast<std::size_t>(line - begin_)).turn;
+}
+
+void Scrollback::DropFrontTurn() {
+    std::size_t turn = Slot(0).turn;
+    while (count_ > 0 && Slot(0).turn == turn) {
+        head_ = (head_ + 1) % slots_.size();
+        --count_;
+        ++begin_;
+    }
+    firstTurn_ = turn + 1;
+}
+
+void Scrollback::DropBackTurn() {
+    std::size_t turn = Slot(count_ - 1).turn;
+    while (count_ > 0 && Slot(count_ - 1).turn == turn) --count_;
+    endTurn_ = turn;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "TextLayout.h"
+
+/**
+ * 대화 기록을 화면 폭에 맞춰 줄바꿈한 뒤 줄 단위로 보관하는 스크롤백 뷰 모델입니다.
+ *
+ * 줄은 고정 용량 링 버퍼에 두고, 연속된 턴 구간 [FirstTurn, EndTurn)만 메모리에 올립니다.
+ * 턴은 필요할 때 앞(과거)이나 뒤(최신)에 덧붙이며, 용량을 넘으면 반대쪽 끝의 턴을 통째로 버립니다.
+ * 줄 위치는 절대 번호(Begin ~ End)로 매기므로 앞쪽에 덧붙이거나 버려도 보고 있던 위치가 바뀌지 않습니다.
+ * 줄바꿈 결과는 LayoutCache에서 (턴, 폭)별로 받아 공유하므로 같은 턴을 다시 불러와도 다시 계산하지 않습니다.
+ */
+class Scrollback {
+public:
+    explicit Scrollback(LayoutCache& layouts, std::size_t capacity = 2048);
+
+    // 모두 비우고 줄바꿈 폭과 시작 턴 위치를 정합니다. (처음에는 FirstTurn == EndTurn == turn)
+    void Reset(int width, std::size_t turn);
+
+    // EndTurn 위치의 턴을 뒤에 덧붙입니다.
+    void AppendTurn(std::string_view text);
+
+    // FirstTurn 바로 앞의 턴을 앞에 덧붙입니다.
+    void PrependTurn(std::string_view text);
+
+    std::size_t FirstTurn() const { return firstTurn_; }
+    std::size_t EndTurn() const { return endTurn_; }
+    int Width() const { return width_; }
+
+    // 보관 중인 줄의 절대 번호 구간 [Begin, End)
+    std::int64_t Begin() const { return begin_; }
+    std::int64_t End() const { return begin_ + static_cast<std::int64_t>(count_); }
+
+    // 절대 번호 `line`의 줄을 반환합니다. (Begin() <= line < End())
+    const std::string& At(std::int64_t line) const;
+
+    // 절대 번호 `line`의 줄이 속한 턴 번호를 반환합니다.
+    std::size_t TurnAt(std::int64_t line) const;
+
+private:
+    struct Line {
+        LayoutCache::Lines lines;  // 이 줄이 속한 턴의 줄바꿈 결과
+        std::uint32_t index = 0;   // 그 안에서의 줄 번호
+        std::size_t turn = 0;
+    };
+
+    // 턴을 링 버퍼에 넣습니다. 용량보다 긴 턴은 앞쪽(prepend) 또는 뒤쪽(append) 줄만 남깁니다.
+    void Insert(const LayoutCache::Lines& lines, std::size_t turn, bool prepend);
+
+    Line& Slot(std::size_t i) { return slots_[(head_ + i) % slots_.size()]; }
+    const Line& Slot(std::size_t i) const { return slots_[(head_ + i) % slots_.size()]; }
+
+    // 가장 오래된 턴 / 가장 최신 턴의 줄을 모두 버립니다.
+    void DropFrontTurn();
+    void DropBackTurn();
+
+    LayoutCache& layouts_;
+    std::vector<Line> slots_;
+    std::size_t head_ = 0;
+    std::size_t count_ = 0;
+    std::int64_t begin_ = 0;
+    std::size_t firstTurn_ = 0;
+    std::size_t endTurn_ = 0;
+    int width_ = 80;
+};
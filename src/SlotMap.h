@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * 슬롯 맵이 돌려주는 핸들입니다. 슬롯 번호와 세대 번호로 이루어지며,
+ * 값이 지워지면 세대가 바뀌므로 오래된 핸들은 조회에 실패합니다. (포인터처럼 매달리지 않음)
+ */
+struct SlotHandle {
+    std::uint32_t index = kInvalidIndex;
+    std::uint32_t generation = 0;
+
+    static constexpr std::uint32_t kInvalidIndex = 0xFFFFFFFFu;
+
+    bool IsNull() const { return index == kInvalidIndex; }
+    bool operator==(const SlotHandle& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const SlotHandle& other) const { return !(*this == other); }
+};
+
+/**
+ * 핸들로 값을 관리하는 컨테이너입니다.
+ *
+ * 값은 `values_`에 빈틈없이 저장되어 순회가 빠르고, 슬롯 테이블을 거쳐 O(1)로 조회합니다.
+ * 값이 재배치되어도 핸들은 그대로 유효하며, 지워진 값의 핸들은 nullptr을 돌려받습니다.
+ * 지울 때는 마지막 값을 빈자리로 옮기므로 순회 순서는 보장하지 않습니다.
+ */
+template <typename T>
+class SlotMap {
+public:
+    // 값을 추가하고 핸들을 반환합니다.
+    SlotHandle Insert(T value) {
+        std::uint32_t slot;
+        if (freeHead_ != SlotHandle::kInvalidIndex) {
+            slot = freeHead_;
+            freeHead_ = slots_[slot].next;
+        } else {
+            slot = static_cast<std::uint32_t>(slots_.size());
+            slots_.push_back(Slot{});
+        }
+        slots_[slot].next = static_cast<std::uint32_t>(values_.size());
+        slots_[slot].free = false;
+        values_.push_back(std::move(value));
+        owners_.push_back(slot);
+        return SlotHandle{slot, slots_[slot].generation};
+    }
+
+    // 핸들이 가리키는 값을 지웁니다. 이미 지워진 핸들이면 false를 반환합니다.
+    bool Erase(SlotHandle handle) {
+        if (!Contains(handle)) return false;
+        Slot& slot = slots_[handle.index];
+        std::uint32_t dense = slot.next;
+        std::uint32_t last = static_cast<std::uint32_t>(values_.size() - 1);
+        if (dense != last) {
+            values_[dense] = std::move(values_[last]);
+            owners_[dense] = owners_[last];
+            slots_[owners_[dense]].next = dense;
+        }
+        values_.pop_back();
+        owners_.pop_back();
+        Release(handle.index);
+        return true;
+    }
+
+    // 모든 값을 지웁니다. 이전에 발급한 핸들은 모두 무효가 됩니다.
+    void Clear() {
+        for (std::uint32_t slot : owners_) Release(slot);
+        values_.clear();
+        owners_.clear();
+    }
+
+    // 핸들이 살아 있는 값을 가리키는지 반환합니다.
+    bool Contains(SlotHandle handle) const {
+        return handle.index < slots_.size() && slots_[handle.index].generation == handle.generation &&
+               !slots_[handle.index].free;
+    }
+
+    // 핸들이 가리키는 값을 반환합니다. 지워졌거나 빈 핸들이면 nullptr을 반환합니다.
+    T* Get(SlotHandle handle) { return Contains(handle) ? &values_[slots_[handle.index].next] : nullptr; }
+    const T* Get(SlotHandle handle) const {
+        return Contains(handle) ? &values_[slots_[handle.index].next] : nullptr;
+    }
+
+    std::size_t Size() const { return values_.size(); }
+    bool Empty() const { return values_.empty(); }
+
+    // 저장된 값을 연속된 메모리로 순회합니다.
+    typename std::vector<T>::iterator begin() { return values_.begin(); }
+    typename std::vector<T>::iterator end() { return values_.end(); }
+    typename std::vector<T>::const_iterator begin() const { return values_.begin(); }
+    typename std::vector<T>::const_iterator end() const { return values_.end(); }
+
+private:
+    struct Slot {
+        std::uint32_t next = 0;        // 사용 중이면 values_ 위치, 비어 있으면 다음 빈 슬롯
+        std::uint32_t generation = 0;
+        bool free = false;
+    };
+
+    void Release(std::uint32_t index) {
+        Slot& slot = slots_[index];
+        ++slot.generation;
+        slot.free = true;
+        slot.next = freeHead_;
+        freeHead_ = index;
+    }
+
+    std::vector<T> values_;
+    std::vector<std::uint32_t> owners_;  // values_[i]를 가리키는 슬롯 번호
+    std::vector<Slot> slots_;
+    std::uint32_t freeHead_ = SlotHandle::kInvalidIndex;
+};
@@ -0,0 +1,93 @@
+#include "StageTable.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+namespace {
+// 기본 단계가 시작되는 호감도 (단계 0, 1, 2, 3)
+constexpr std::array<int, 4> kDefaultStageFloors{0, 25, 50, 75};
+
+// 단계 번호는 표에 1바이트로 저장합니다.
+constexpr int kMaxStageCount = 256;
+
+struct StageRange {
+    int low;
+    int high;
+    int stage;
+};
+}  // 익명 네임스페이스 종료
+
+StageTable::StageTable() : stageCount_(static_cast<int>(kDefaultStageFloors.size())) {
+    for (int affection = kMinAffection; affection <= kMaxAffection; ++affection) {
+        int stage = 0;
+        while (stage + 1 < stageCount_ && affection >= kDefaultStageFloors[stage + 1]) ++stage;
+        stageByAffection_[affection - kMinAffection] = static_cast<std::uint8_t>(stage);
+    }
+}
+
+bool StageTable::Load(const nlohmann::json& affectionToStage) {
+    if (!affectionToStage.is_object() || affectionToStage.empty()) {
+        std::cerr << "[StageTable] affectionToStage는 비어 있지 않은 객체여야 합니다.\n";
+        return false;
+    }
+
+    std::vector<StageRange> ranges;
+    for (const auto& [key, value] : affectionToStage.items()) {
+        StageRange range{};
+        char tail = '\0';
+        // "0-24", "-100--1" 처럼 하한과 상한을 '-'로 잇습니다.
+        if (std::sscanf(key.c_str(), "%d-%d%c", &range.low, &range.high, &tail) != 2 || range.low > range.high ||
+            !value.is_number_integer() || value.get<int>() < 0 || value.get<int>() >= kMaxStageCount) {
+            std::cerr << "[StageTable] 잘못된 단계 구간입니다: \"" << key << "\": " << value.dump() << '\n';
+            return false;
+        }
+        range.stage = value.get<int>();
+        range.low = std::max(range.low, kMinAffection);
+        range.high = std::min(range.high, kMaxAffection);
+        if (range.low <= range.high) ranges.push_back(range);
+    }
+    if (ranges.empty()) {
+        std::cerr << "[StageTable] 호감도 범위(" << kMinAffection << "~" << kMaxAffection << ")에 걸치는 구간이 없습니다.\n";
+        return false;
+    }
+    std::sort(ranges.begin(), ranges.end(), [](const StageRange& a, const StageRange& b) { return a.low < b.low; });
+
+    // 구간을 먼저 칠하고(겹치면 하한이 낮은 구간 우선), 빈틈은 바로 아래 값의 단계로 채웁니다.
+    // 가장 낮은 구간 아래는 그 구간의 단계를 씁니다.
+    std::array<int, kMaxAffection - kMinAffection + 1> painted;
+    painted.fill(-1);
+    for (const auto& range : ranges) {
+        for (int affection = range.low; affection <= range.high; ++affection) {
+            int& slot = painted[affection - kMinAffection];
+            if (slot < 0) slot = range.stage;
+        }
+    }
+
+    decltype(stageByAffection_) table;
+    int stageCount = 0;
+    int current = ranges.front().stage;
+    for (std::size_t i = 0; i < painted.size(); ++i) {
+        if (painted[i] >= 0) current = painted[i];
+        table[i] = static_cast<std::uint8_t>(current);
+        stageCount = std::max(stageCount, current + 1);
+    }
+
+    stageByAffection_ = table;
+    stageCount_ = stageCount;
+    return true;
+}
+
+int StageTable::StageOf(int affection) const {
+    return stageByAffection_[std::clamp(affection, kMinAffection, kMaxAffection) - kMinAffection];
+}
+
+int StageTable::StageCount() const {
+    return stageCount_;
+}
+
+const StageTable& StageTable::Default() {
+    static const StageTable table;
+    return table;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include <nlohmann/json.hpp>
+
+/**
+ * 호감도에서 관계 단계를 구하는 표입니다.
+ *
+ * 캐릭터 파일의 `affectionToStage`(`"0-24": 0` 형식의 구간)를 읽어 만들며,
+ * 만들 때 가능한 모든 호감도 값에 대한 단계를 미리 계산해 두므로 조회는 배열 접근 한 번입니다.
+ * 구간이 빠진 호감도는 바로 아래 구간의 단계를 따릅니다.
+ */
+class StageTable {
+public:
+    static constexpr int kMinAffection = -100;
+    static constexpr int kMaxAffection = 100;
+
+    // 기본 단계 구성(0/25/50/75에서 올라가는 4단계)으로 만듭니다.
+    StageTable();
+
+    // `affectionToStage` 객체를 읽어 표를 만듭니다. 형식이 잘못되면 false를 반환하고 표는 바뀌지 않습니다.
+    bool Load(const nlohmann::json& affectionToStage);
+
+    // 호감도에 해당하는 단계를 반환합니다. 범위를 벗어난 값은 양 끝으로 맞춥니다.
+    int StageOf(int affection) const;
+
+    // 단계 수(가장 높은 단계 + 1)를 반환합니다.
+    int StageCount() const;
+
+    // 캐릭터 파일에 표가 없을 때 쓰는 기본 표를 반환합니다.
+    static const StageTable& Default();
+
+private:
+    std::array<std::uint8_t, kMaxAffection - kMinAffection + 1> stageByAffection_;
+    int stageCount_;
+};
@@ -1,79 +1,196 @@
 #include "TUI.h"
 
-#include <conio.h> // Windows에서 _getch 사용
+#include <algorithm>
 #include <iostream>
+#include <cstdio>
 #include <cstdlib>
-#include <windows.h> // 콘솔 색상/코드페이지 설정용
-#include <thread>
-#include <chrono>
 
-#define KEY_UP 72
-#define KEY_DOWN 80
-#define KEY_ENTER 13
+#include "Config.h"
 
-TUI::TUI() {
-    // UTF-8 출력 강제
-    SetConsoleOutputCP(CP_UTF8);
+namespace {
+// 기록 화면이 한 번에 불러오는 턴 수
+constexpr std::size_t kHistoryBatch = 16;
 
-    // 콘솔 글꼴과 크기 설정
-    SetupConsole();
-    
+// 커서 위치 저장/복원 (DECSC/DECRC). 상태 표시줄을 그린 뒤 대화 출력 위치로 돌아옵니다.
+constexpr const char* kSaveCursor = "\x1b" "7";
+constexpr const char* kRestoreCursor = "\x1b" "8";
+
+// 채팅 화면에 출력하던 모양 그대로 한 턴을 만듭니다. (앞의 빈 줄 포함)
+std::string FormatEntry(const TUI::HistoryEntry& entry) {
+    switch (entry.kind) {
+        case TUI::HistoryEntry::Kind::Player: return "\n[Player]: " + entry.text;
+        case TUI::HistoryEntry::Kind::Npc: return "\n[" + entry.speaker + "] " + entry.text;
+        case TUI::HistoryEntry::Kind::System: break;
+    }
+    return "\n" + entry.text;
+}
+
+// 상태 표시줄의 수치 하나를 만듭니다. 모르는 값(음수)은 "-"로 표시합니다.
+std::string StatusCount(int value) {
+    return value < 0 ? std::string("-") : std::to_string(value);
+}
+
+std::string StatusDecimal(double value, const char* unit) {
+    if (value < 0.0) return "-";
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.1f%s", value, unit);
+    return buffer;
+}
+
+// 폭이 좁으면 뒤쪽이 잘리므로 자주 바뀌는 응답 수치를 앞에 둡니다.
+std::string FormatStatus(const TUI::ChatStatus& status) {
+    std::string line = " " + status.provider + "/" + status.model;
+    line += " | 첫 토큰 " + StatusDecimal(status.timeToFirstToken, "s");
+    line += " | " + StatusDecimal(status.tokensPerSecond, " tok/s");
+    line += " | 토큰 입력 " + StatusCount(status.promptTokens) + " / 출력 " + StatusCount(status.completionTokens);
+    line += " | 캐시 " + StatusCount(status.cachedTokens);
+    line += " | 호감도 " + std::to_string(status.affection);
+    if (!status.stage.empty()) line += " (" + status.stage + ")";
+    return line;
+}
+}  // 익명 네임스페이스 종료
+
+TUI::TUI(const Config& config)
+    : scrollback_(layouts_),
+      statusEnabled_(config.GetStatusBar()),
+      typewriter_(terminal_, config.GetTypingCharsPerSecond(), config.GetTypingFrameRate()) {
     // 메뉴 화면에서는 커서를 숨김(미관용)
-    HANDLE hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
-    CONSOLE_CURSOR_INFO cursorInfo;
-    GetConsoleCursorInfo(hConsole, &cursorInfo);
-    cursorInfo.bVisible = FALSE;
-    SetConsoleCursorInfo(hConsole, &cursorInfo);
+    terminal_.SetCursorVisible(false);
+
+    // 키는 도착하는 대로 이벤트 루프가 읽고, 출력이 끝나면 렌더 스레드가 루프를 깨웁니다.
+    terminal_.SetRawInput(true);
+    loop_.SetInputHandler([this]() { OnInput(); });
+    typewriter_.SetOnIdle([poster = loop_.GetPoster()]() { poster.Post([]() {}); });
+    statusBuffer_.SetOrigin(0);
 }
 
 TUI::~TUI() {
-    // 커서 표시 상태 복구
-    HANDLE hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
-    CONSOLE_CURSOR_INFO cursorInfo;
-    GetConsoleCursorInfo(hConsole, &cursorInfo);
-    cursorInfo.bVisible = TRUE;
-    SetConsoleCursorInfo(hConsole, &cursorInfo);
+    // 남은 출력을 내보낸 뒤 스크롤 영역과 커서 표시 상태 복구
+    typewriter_.Stop();
+    HideStatus();
+    terminal_.SetRawInput(false);
+    terminal_.SetCursorVisible(true);
+}
+
+void TUI::Print(std::string_view text) {
+    if (!editing_) {
+        typewriter_.Print(text);
+        return;
+    }
+    // 입력 중인 줄(여러 줄로 넘어갔으면 그 줄들 모두)을 지우고 그 자리에 텍스트를 쓴 뒤 입력 줄을 다시 그립니다.
+    // 입력 줄 위에는 이미 빈 줄이 있으므로 텍스트 앞의 줄바꿈 하나는 생략합니다.
+    int columns = 0;
+    int rows = 0;
+    terminal_.Size(columns, rows);
+    int width = TextLayout::Width(editPrompt_) + TextLayout::Width(editLine_);
+    int above = width > 0 ? (width - 1) / std::max(columns, 1) : 0;
+
+    std::string out = "\r";
+    if (above > 0) out += "\x1b[" + std::to_string(above) + "A";
+    out += "\x1b[J";
+    if (!text.empty() && text.front() == '\n') text.remove_prefix(1);
+    out += text;
+    if (out.back() != '\n') out += '\n';
+    out += "\n" + editPrompt_ + editLine_;
+    typewriter_.Print(out);
 }
 
 void TUI::ClearScreen() {
-    system("cls");
+    // 타이핑 중인 대사를 다 보여준 뒤에 지웁니다.
+    FinishTyping();
+    terminal_.Clear();
+    // 줄 단위 출력으로 화면이 바뀌었으므로 다음 전체 화면은 처음부터 그립니다.
+    screen_.Invalidate();
+    if (statusVisible_) {
+        // 함께 지워진 상태 표시줄을 다시 그리고, 대화는 그 아래 줄부터 시작합니다.
+        terminal_.Write("\x1b[2;1H");
+        statusBuffer_.Invalidate();
+        RenderStatus();
+    }
 }
 
-void TUI::RenderMenu(int selectedIndex) {
-    ClearScreen();
-    std::cout << "\n================================================\n\n";
-    std::cout << "\t\t   봄날의 추억\n\n";
-    std::cout << "================================================\n\n";
+void TUI::UpdateStatus(const ChatStatus& status) {
+    status_ = status;
+    if (statusVisible_) RenderStatus();
+}
 
-    const std::vector<std::string> options = {"새 플레이", "불러오기", " 나가기"};
-    
+void TUI::RenderStatus() {
+    int columns = 0;
+    int rows = 0;
+    terminal_.Size(columns, rows);
+    if (rows != statusRows_) {
+        // 맨 윗줄을 뺀 나머지를 스크롤 영역으로 잡습니다. 영역을 바꾸면 커서가 맨 위로 가므로 위치를 저장해 둡니다.
+        // 대화 출력과 순서가 섞이지 않도록 타자 효과 큐를 거칩니다.
+        typewriter_.Print(kSaveCursor + ("\x1b[2;" + std::to_string(std::max(rows, 2)) + "r") + kRestoreCursor);
+        statusRows_ = rows;
+    }
+
+    statusBuffer_.Resize(columns, 1);
+    statusBuffer_.Clear();
+    statusBuffer_.Put(0, 0, std::string(static_cast<std::size_t>(columns), ' '), ScreenBuffer::kReverse);
+    statusBuffer_.Put(0, 0, FormatStatus(status_), ScreenBuffer::kReverse);
+    // 바뀐 칸만 커서 위치를 저장한 채로 그리므로, 타자 효과 중인 대사 사이에 끼워 넣어도 됩니다.
+    std::string diff = statusBuffer_.Flush();
+    if (!diff.empty()) typewriter_.Overlay(kSaveCursor + diff + kRestoreCursor);
+}
+
+void TUI::HideStatus() {
+    // 타자 효과 큐를 거치지 않으므로 출력이 모두 끝난 뒤에만 부릅니다.
+    if (!statusVisible_) return;
+    statusVisible_ = false;
+    statusRows_ = 0;
+    terminal_.Write(std::string(kSaveCursor) + "\x1b[r" + kRestoreCursor);
+}
+
+void TUI::RenderMenu(int selectedIndex) {
+    int columns = 0;
+    int rows = 0;
+    terminal_.Size(columns, rows);
+    screen_.Resize(columns, rows);
+    screen_.Clear();
+
+    const std::string rule(48, '=');
+    const std::vector<std::string> options = {"새 플레이", "불러오기", "나가기"};
+
+    int row = 1;
+    screen_.PutCentered(row++, rule);
+    screen_.PutCentered(++row, "봄날의 추억", ScreenBuffer::kBold);
+    row += 2;
+    screen_.PutCentered(row++, rule);
+    ++row;
     for (int i = 0; i < 3; ++i) {
         if (i == selectedIndex) {
-            std::cout << "\t\t  > " << options[i] << " <\n";
+            screen_.PutCentered(row++, "> " + options[i] + " <", ScreenBuffer::kReverse);
         } else {
-            std::cout << "\t\t    " << options[i] << "\n";
+            screen_.PutCentered(row++, options[i]);
         }
     }
+    ++row;
+    screen_.PutCentered(row++, rule);
+    screen_.PutCentered(row++, "저장: /save, 종료: /quit, 재시작: /restart");
+    screen_.PutCentered(row++, rule);
 
-    std::cout << "\n================================================\n";
-    std::cout << "저장: /save, 종료: /quit, 재시작: /restart\n";
-    std::cout << "================================================\n";
+    // 선택이 바뀐 줄만 다시 쓰므로 화면 전체를 지우고 그리는 깜빡임이 없습니다.
+    terminal_.Write(screen_.Flush());
 }
 
 TUI::MenuOption TUI::ShowMainMenu() {
     int selected = 0;
+    FinishTyping();
+    HideStatus();
+    keys_.clear();
+    terminal_.SetCursorVisible(false);
     while (true) {
         RenderMenu(selected);
-        
-        int c = _getch();
-        if (c == 224) { // 방향키 입력을 알리는 프리픽스
-            c = _getch();
-            if (c == KEY_UP) {
-                selected = (selected - 1 + 3) % 3;
-            } else if (c == KEY_DOWN) {
-                selected = (selected + 1) % 3;
-            }
-        } else if (c == KEY_ENTER) {
+
+        Terminal::Key key = NextKey();
+        if (key.code == Terminal::KeyCode::Up) {
+            selected = (selected - 1 + 3) % 3;
+        } else if (key.code == Terminal::KeyCode::Down) {
+            selected = (selected + 1) % 3;
+        } else if (key.code == Terminal::KeyCode::Interrupt) {
+            return MenuOption::Exit;
+        } else if (key.code == Terminal::KeyCode::Enter) {
             if (selected == 0) return MenuOption::NewGame;
             if (selected == 1) return MenuOption::LoadGame;
             if (selected == 2) return MenuOption::Exit;
@@ -82,106 +199,342 @@ TUI::MenuOption TUI::ShowMainMenu() {
 }
 
 void TUI::ShowChatScreen(const std::string& characterName) {
+    // 상태 표시줄을 켜면 ClearScreen이 맨 윗줄에 그리고 스크롤 영역을 잡습니다.
+    if (statusEnabled_ && !statusVisible_) {
+        statusVisible_ = true;
+        statusRows_ = 0;
+    }
     ClearScreen();
-    std::cout << "================================================\n";
-    std::cout << "대화 상대: " << characterName << "\n";
-    std::cout << "================================================\n\n";
-    
+    Print("================================================\n"
+          "대화 상대: " + characterName + "\n"
+          "================================================\n\n");
+
     // 채팅 화면에서는 커서를 다시 보이게 함
-    HANDLE hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
-    CONSOLE_CURSOR_INFO cursorInfo;
-    GetConsoleCursorInfo(hConsole, &cursorInfo);
-    cursorInfo.bVisible = TRUE;
-    SetConsoleCursorInfo(hConsole, &cursorInfo);
+    terminal_.SetCursorVisible(true);
+}
+
+std::string TUI::Wrapped(std::string_view text) {
+    int columns = 0;
+    int rows = 0;
+    terminal_.Size(columns, rows);
+    // 마지막 칸까지 채우면 터미널이 스스로 줄을 넘기는 경우가 있어 한 칸을 남깁니다.
+    TextLayout::Wrap(text, columns - 1, wrapped_);
+    std::string joined;
+    for (const std::string& line : wrapped_) {
+        if (!joined.empty()) joined += '\n';
+        joined += line;
+    }
+    return joined;
 }
 
 void TUI::PrintSystem(const std::string& text) {
-    std::cout << "\n" << text << "\n";
+    Print("\n" + Wrapped(text) + "\n");
 }
 
-void TUI::PrintNpc(const std::string& name, const std::string& text) {
-    std::cout << "\n[" << name << "] " << text << "\n";
+void TUI::PrintNpc(const std::string& name, std::string_view text) {
+    Print("\n" + Wrapped("[" + name + "] " + std::string(text)) + "\n");
 }
 
-void TUI::PrintPlayer(const std::string& text) {
+void TUI::PrintPlayer(std::string_view text) {
     if (text.empty()) return;
-    std::cout << "\n[Player]: " << text << "\n";
+    Print("\n" + Wrapped("[Player]: " + std::string(text)) + "\n");
 }
 
 void TUI::PrintNpcTyped(const std::string& name, const std::string& text) {
+    BeginNpcStream(name);
+    AppendNpcStream(text);
+    EndNpcStream();
+}
+
+void TUI::BeginNpcStream(const std::string& name) {
     NewLine();
-    PrintChunk("[" + name + "] ");
-    PrintChunk(text);
+    streamText_ = "[" + name + "] ";
+    streamLines_ = 0;
+    streamColumn_ = 0;
+}
+
+void TUI::AppendNpcStream(std::string_view text) {
+    streamText_ += text;
+    FlushStream(false);
+}
+
+void TUI::EndNpcStream() {
+    FlushStream(true);
     NewLine();
 }
 
+void TUI::FlushStream(bool all) {
+    int columns = 0;
+    int rows = 0;
+    terminal_.Size(columns, rows);
+    // 대사 한 편은 짧으므로 조각마다 처음부터 다시 줄바꿈해도 충분히 쌉니다.
+    TextLayout::Wrap(streamText_, columns - 1, wrapped_);
+
+    std::string out;
+    while (streamLines_ < wrapped_.size()) {
+        const std::string& line = wrapped_[streamLines_];
+        bool complete = all || streamLines_ + 1 < wrapped_.size();
+        // 마지막 줄의 끝 어절은 뒤에 올 조각에 따라 다음 줄로 넘어갈 수 있으므로 마지막 공백 앞까지만 냅니다.
+        std::size_t end = line.size();
+        if (!complete) {
+            std::size_t space = line.rfind(' ');
+            end = space == std::string::npos ? 0 : space;
+        }
+        if (complete || end > streamColumn_) {
+            if (streamColumn_ == 0 && streamLines_ > 0) out += '\n';
+            if (end > streamColumn_) out.append(line, streamColumn_, end - streamColumn_);
+            streamColumn_ = end;
+        }
+        if (!complete) break;
+        ++streamLines_;
+        streamColumn_ = 0;
+    }
+    typewriter_.Type(out);
+}
+
+void TUI::LoadHistory(const HistorySource& source, std::size_t begin, std::size_t end, bool prepend) {
+    historyBatch_.clear();
+    source(begin, end, historyBatch_);
+    if (prepend) {
+        for (auto it = historyBatch_.rbegin(); it != historyBatch_.rend(); ++it) scrollback_.PrependTurn(FormatEntry(*it));
+    } else {
+        for (const HistoryEntry& entry : historyBatch_) scrollback_.AppendTurn(FormatEntry(entry));
+    }
+}
+
+void TUI::ShowRecentHistory(std::size_t turnCount, const HistorySource& source) {
+    int columns = 0;
+    int rows = 0;
+    terminal_.Size(columns, rows);
+    // 머리글과 입력 줄을 빼고 남는 줄 수만큼만 최근 턴부터 거꾸로 불러옵니다.
+    const std::int64_t pageRows = std::max(rows - (statusVisible_ ? 7 : 6), 1);
+    scrollback_.Reset(columns - 1, turnCount);
+    while (scrollback_.End() - scrollback_.Begin() < pageRows && scrollback_.FirstTurn() > 0) {
+        std::size_t end = scrollback_.FirstTurn();
+        LoadHistory(source, end > kHistoryBatch ? end - kHistoryBatch : 0, end, true);
+    }
+
+    std::int64_t top = std::max(scrollback_.Begin(), scrollback_.End() - pageRows);
+    std::string text;
+    if (top > scrollback_.Begin() || scrollback_.FirstTurn() > 0) {
+        text += "(이전 대화는 /history 로 볼 수 있습니다)\n";
+    }
+    for (std::int64_t line = top; line < scrollback_.End(); ++line) {
+        text += scrollback_.At(line);
+        text += '\n';
+    }
+    Print(text);
+}
 
+void TUI::RenderHistory(std::int64_t top, int pageRows, std::size_t turnCount) {
+    screen_.Clear();
+    const int columns = screen_.Columns();
+    std::int64_t bottom = std::min(top + pageRows, scrollback_.End());
 
-void TUI::ShowEvent(const std::string& title, const std::vector<std::string>& lines) {
+    std::string title = " 대화 기록";
+    if (bottom > top) {
+        title += "  (" + std::to_string(scrollback_.TurnAt(top) + 1) + "-" +
+                 std::to_string(scrollback_.TurnAt(bottom - 1) + 1) + " / " + std::to_string(turnCount) + "턴)";
+    }
+    screen_.Put(0, 0, std::string(static_cast<std::size_t>(columns), ' '), ScreenBuffer::kReverse);
+    screen_.Put(0, 0, title, ScreenBuffer::kReverse);
+
+    for (std::int64_t line = top; line < bottom; ++line) {
+        screen_.Put(0, 1 + static_cast<int>(line - top), scrollback_.At(line));
+    }
+    screen_.Put(0, screen_.Rows() - 1, "PgUp/PgDn: 페이지  ↑/↓: 한 줄  Esc/q: 닫기", ScreenBuffer::kBold);
+    terminal_.Write(screen_.Flush());
+}
+
+void TUI::BrowseHistory(std::size_t turnCount, const HistorySource& source) {
+    FinishTyping();
+    // 스크롤 영역은 대체 화면에도 적용되므로 닫을 때까지 풀어 둡니다.
+    const bool hadStatus = statusVisible_;
+    HideStatus();
+    // 대체 화면에 그리므로 닫으면 채팅 화면이 다시 출력할 필요 없이 그대로 돌아옵니다.
+    terminal_.SetAlternateScreen(true);
+    terminal_.SetCursorVisible(false);
+    screen_.Invalidate();
+
+    int columns = 0;
+    int rows = 0;
+    int pageRows = 1;
+    std::int64_t top = 0;
+
+    // 보이는 구간 앞뒤로 부족한 턴만 불러오고, 위치를 기록 범위 안으로 맞춥니다.
+    auto settle = [&]() {
+        while (top + pageRows > scrollback_.End() && scrollback_.EndTurn() < turnCount) {
+            std::size_t begin = scrollback_.EndTurn();
+            LoadHistory(source, begin, std::min(begin + kHistoryBatch, turnCount), false);
+        }
+        top = std::min(top, scrollback_.End() - pageRows);
+        while (top < scrollback_.Begin() && scrollback_.FirstTurn() > 0) {
+            std::size_t end = scrollback_.FirstTurn();
+            LoadHistory(source, end > kHistoryBatch ? end - kHistoryBatch : 0, end, true);
+        }
+        top = std::max(top, scrollback_.Begin());
+    };
+
+    // 화면 크기에 맞춰 `anchorTurn`부터 다시 줄바꿈합니다. 맨 끝에서 시작하면 마지막 페이지를 보여줍니다.
+    auto layout = [&](std::size_t anchorTurn) {
+        terminal_.Size(columns, rows);
+        screen_.Resize(columns, rows);
+        pageRows = std::max(rows - 2, 1);  // 제목 줄과 도움말 줄 제외
+        scrollback_.Reset(columns, anchorTurn);
+        top = anchorTurn == turnCount ? -pageRows : 0;
+        settle();
+    };
+
+    layout(turnCount);
+    while (true) {
+        RenderHistory(top, pageRows, turnCount);
+
+        Terminal::Key key = NextKey();
+        switch (key.code) {
+            case Terminal::KeyCode::Up: top -= 1; break;
+            case Terminal::KeyCode::Down: top += 1; break;
+            case Terminal::KeyCode::PageUp: top -= pageRows; break;
+            case Terminal::KeyCode::PageDown: top += pageRows; break;
+            case Terminal::KeyCode::Char:
+                if (key.ch != 'q' && key.ch != 'Q') continue;
+                [[fallthrough]];
+            case Terminal::KeyCode::Escape:
+            case Terminal::KeyCode::Enter:
+            case Terminal::KeyCode::Interrupt:
+                terminal_.SetAlternateScreen(false);
+                terminal_.SetCursorVisible(true);
+                screen_.Invalidate();
+                if (hadStatus) {
+                    statusVisible_ = true;
+                    statusBuffer_.Invalidate();
+                    RenderStatus();
+                }
+                return;
+            default: continue;
+        }
+
+        int nowColumns = 0;
+        int nowRows = 0;
+        terminal_.Size(nowColumns, nowRows);
+        if (nowColumns != columns || nowRows != rows) {
+            bool empty = scrollback_.End() == scrollback_.Begin();
+            layout(empty ? turnCount : scrollback_.TurnAt(std::clamp(top, scrollback_.Begin(), scrollback_.End() - 1)));
+        } else {
+            settle();
+        }
+    }
+}
+
+void TUI::BeginEvent(const std::string& title) {
     ClearScreen();
     PrintSystem(">>> EVENT: " + title + " <<<");
     NewLine();
-    
-    for (const auto& line : lines) {
-        PrintChunk(line);
-        NewLine();
-        WaitForKey(); 
+}
+
+void TUI::ShowEventLine(const std::string& speaker, const std::string& text) {
+    // 화자가 없으면 해설로 출력
+    PrintChunk(Wrapped(speaker.empty() ? text : "[" + speaker + "] " + text));
+    NewLine();
+    WaitForKey();
+}
+
+std::size_t TUI::ShowEventChoices(const std::vector<std::string>& options) {
+    NewLine();
+    for (std::size_t i = 0; i < options.size(); ++i) {
+        Print(Wrapped("  " + std::to_string(i + 1) + ". " + options[i]) + "\n");
     }
-    
+    while (true) {
+        std::string input = ReadInput("선택> ");
+        if (quitRequested_) return 0;  // 호출자가 QuitRequested()를 보고 선택을 버립니다.
+        try {
+            int idx = std::stoi(input);
+            if (idx >= 1 && idx <= static_cast<int>(options.size())) return static_cast<std::size_t>(idx - 1);
+        } catch (...) {
+            // 숫자가 아니면 다시 묻습니다.
+        }
+    }
+}
+
+void TUI::EndEvent() {
     PrintSystem(">>> 이벤트 종료 (Enter) <<<");
     WaitForKey();
 }
 
 std::string TUI::ReadInput(const std::string& prompt) {
-    std::cout << "\n" << prompt;
-    std::string input;
-    std::getline(std::cin, input);
-    return input;
+    Print("\n" + prompt);
+    // 입력 줄이 화면에 나온 뒤부터 도착하는 메시지는 Print가 입력 줄 위에 끼워 넣습니다.
+    editing_ = true;
+    editPrompt_ = prompt;
+    editLine_.clear();
+    FinishTyping();
+
+    // 미리 입력해 둔 키가 있으면 그것부터 처리합니다.
+    while (true) {
+        Terminal::Key key = NextKey();
+        if (key.code == Terminal::KeyCode::Enter) break;
+        if (key.code == Terminal::KeyCode::Interrupt) {
+            editLine_.clear();
+            typewriter_.Print("^C");
+            RequestQuit();
+            break;
+        }
+
+        if (key.code == Terminal::KeyCode::Backspace) {
+            if (editLine_.empty()) continue;
+            // UTF-8 글자 하나를 지우고, 화면에서는 그 글자의 폭만큼 지웁니다.
+            std::size_t start = editLine_.size() - 1;
+            while (start > 0 && (static_cast<unsigned char>(editLine_[start]) & 0xC0) == 0x80) --start;
+            int width = TextLayout::Width(std::string_view(editLine_).substr(start));
+            editLine_.erase(start);
+            std::string back(static_cast<std::size_t>(width), '\b');
+            typewriter_.Print(back + std::string(static_cast<std::size_t>(width), ' ') + back);
+        } else if (key.code == Terminal::KeyCode::Char) {
+            editLine_ += key.ch;
+            typewriter_.Print(std::string_view(&key.ch, 1));
+        }
+    }
+    editing_ = false;
+    typewriter_.Print("\n");
+    return std::move(editLine_);
 }
 
 std::string TUI::ReadPassword(const std::string& prompt) {
-    std::cout << prompt;
+    Print(prompt);
+    FinishTyping();
     std::string password;
-    int ch;
-    while ((ch = _getch()) != KEY_ENTER) {
-        if (ch == 3) { // Ctrl+C 입력 시
-            std::cout << "^C\n";
-            // 종료 전 커서 표시 상태 복구
-            HANDLE hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
-            CONSOLE_CURSOR_INFO cursorInfo;
-            GetConsoleCursorInfo(hConsole, &cursorInfo);
-            cursorInfo.bVisible = TRUE;
-            SetConsoleCursorInfo(hConsole, &cursorInfo);
-            exit(0);
-        }
-        if (ch == 0 || ch == 224) { 
-            _getch();
-            continue;
+    while (true) {
+        Terminal::Key key = NextKey();
+        if (key.code == Terminal::KeyCode::Enter) break;
+        if (key.code == Terminal::KeyCode::Interrupt) {
+            password.clear();
+            terminal_.Write("^C");
+            RequestQuit();
+            break;
         }
 
-        if (ch == '\b') {
+        if (key.code == Terminal::KeyCode::Backspace) {
             if (!password.empty()) {
                 password.pop_back();
-                std::cout << "\b \b";
+                terminal_.Write("\b \b");
             }
-        } else if (ch >= 32 && ch != 127) {
-            password += static_cast<char>(ch);
-            std::cout << '*';
+        } else if (key.code == Terminal::KeyCode::Char) {
+            password += key.ch;
+            terminal_.Write("*");
         }
     }
-    std::cout << std::endl;
+    terminal_.Write("\n");
     return password;
 }
 
 std::string TUI::ShowApiKeyPrompt() {
     ClearScreen();
-    std::cout << "================================================\n";
-    std::cout << "             [ API 설정 필요 ]\n";
-    std::cout << "================================================\n";
-    std::cout << "OpenAI API 키가 설정되지 않았습니다.\n";
-    std::cout << "환경 변수 OPENAI_API_KEY를 설정하거나 직접 입력하세요.\n";
-    std::cout << "(입력한 키는 저장되지 않고 이번 실행에만 사용됩니다)\n\n";
-    
+    Print("================================================\n"
+          "             [ API 설정 필요 ]\n"
+          "================================================\n"
+          "OpenAI API 키가 설정되지 않았습니다.\n"
+          "환경 변수 OPENAI_API_KEY를 설정하거나 직접 입력하세요.\n"
+          "(입력한 키는 저장되지 않고 이번 실행에만 사용됩니다)\n\n");
+
     return ReadPassword("API Key 입력> ");
 }
 
@@ -214,62 +567,65 @@ std::string TUI::GetPlayerInput(const std::string& playerName) {
 }
 
 void TUI::PrintChunk(const std::string& chunk) {
-    for (size_t i = 0; i < chunk.length(); ) {
-        unsigned char c = static_cast<unsigned char>(chunk[i]);
-        int charLen = 1;
-
-        if ((c & 0x80) == 0) charLen = 1;
-        else if ((c & 0xE0) == 0xC0) charLen = 2;
-        else if ((c & 0xF0) == 0xE0) charLen = 3;
-        else if ((c & 0xF8) == 0xF0) charLen = 4;
-        
-        // 완전한 한 글자(1~4바이트)를 출력
-        for (int k = 0; k < charLen && i + k < chunk.length(); ++k) {
-            std::cout << chunk[i + k];
-        }
-        std::cout.flush();
-        
-        i += charLen;
-        
-        // 타이핑 효과를 위한 지연
-        std::this_thread::sleep_for(std::chrono::milliseconds(20));
-
-        // 공백은 지연을 건너뛰어 자연스럽게 만듦
-        if (c == ' ') std::this_thread::sleep_for(std::chrono::milliseconds(0));
-    }
+    // 글자마다 쓰고 잠들던 방식 대신 렌더 스레드가 프레임 단위로 모아 출력합니다.
+    typewriter_.Type(chunk);
 }
 
 void TUI::NewLine() {
-    std::cout << std::endl;
+    Print("\n");
+}
+
+void TUI::FinishTyping() {
+    // 렌더 스레드가 다 쓰면 루프를 깨우므로 프레임마다 확인하지 않습니다. 건너뛰기는 OnInput이 처리합니다.
+    loop_.RunUntil([this]() { return typewriter_.Idle(); });
 }
 
 void TUI::WaitForKey() {
-    _getch();
+    FinishTyping();
+    // 이 화면이 나오기 전에 누른 키로 넘어가지 않도록 새로 누른 키를 기다립니다.
+    keys_.clear();
+    NextKey();
 }
 
-void TUI::SetupConsole() {
-    HANDLE hOut = GetStdHandle(STD_OUTPUT_HANDLE);
-    if (hOut == INVALID_HANDLE_VALUE) return;
+bool TUI::WaitForReply(const std::function<bool()>& done) {
+    awaitingReply_ = true;
+    cancelRequested_ = false;
+    loop_.RunUntil([&]() { return cancelRequested_ || done(); });
+    awaitingReply_ = false;
+    return done();
+}
 
-    // 1. 글꼴 설정
-    CONSOLE_FONT_INFOEX cfi;
-    cfi.cbSize = sizeof(cfi);
-    GetCurrentConsoleFontEx(hOut, FALSE, &cfi);
-    
-    cfi.dwFontSize.Y = 24; // 더 큰 글꼴 높이(24px)
-    cfi.FontWeight = FW_NORMAL;
-    wcscpy_s(cfi.FaceName, L"Consolas"); // 가독성 좋은 모노스페이스 Consolas 사용
-    SetCurrentConsoleFontEx(hOut, FALSE, &cfi);
-
-    // 2. 콘솔 창/버퍼 크기 설정
-    // 충분한 스크롤백 버퍼 확보
-    COORD bufferSize = {120, 3000}; // 폭 120컬럼, 스크롤백 3000줄
-    SetConsoleScreenBufferSize(hOut, bufferSize);
-
-    // 실제 표시되는 창 크기(viewport) 설정
-    SMALL_RECT windowSize = {0, 0, 119, 39}; // 가로 120 x 세로 40 영역
-    SetConsoleWindowInfo(hOut, TRUE, &windowSize);
-    
-    // 선택 사항: 콘솔 제목 설정
-    SetConsoleTitleW(L"AI 연애 시뮬레이터 - 봄날의 추억");
+void TUI::OnInput() {
+    Terminal::Key key;
+    while (terminal_.PollKey(key, 0)) {
+        bool interrupt = key.code == Terminal::KeyCode::Interrupt;
+        if (awaitingReply_ && (interrupt || key.code == Terminal::KeyCode::Escape)) {
+            cancelRequested_ = true;
+        } else if (!typewriter_.Idle() && !interrupt) {
+            // 타이핑 중에 누른 키는 남은 텍스트를 건너뛰게 합니다. 글자는 다음 입력에 쓰이도록 남겨 둡니다.
+            typewriter_.Skip();
+            if (key.code == Terminal::KeyCode::Char) keys_.push_back(key);
+        } else {
+            keys_.push_back(key);
+        }
+        // 입력이 닫혀도 중단 키가 오므로, 여기서 멈추지 않으면 같은 키를 끝없이 읽습니다.
+        if (interrupt) break;
+    }
+}
+
+Terminal::Key TUI::NextKey() {
+    if (quitRequested_) {
+        Terminal::Key key;
+        key.code = Terminal::KeyCode::Interrupt;
+        return key;
+    }
+    loop_.RunUntil([this]() { return !keys_.empty(); });
+    Terminal::Key key = keys_.front();
+    keys_.pop_front();
+    return key;
+}
+
+void TUI::RequestQuit() {
+    quitRequested_ = true;
+    keys_.clear();
 }
@@ -1,11 +1,23 @@
 #pragma once
 
+#include <deque>
+#include <functional>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include "EventLoop.h"
+#include "ScreenBuffer.h"
+#include "Scrollback.h"
+#include "Terminal.h"
+#include "TextLayout.h"
+#include "Typewriter.h"
+
+class Config;
+
 class TUI {
 public:
-    TUI();
+    explicit TUI(const Config& config);
     ~TUI();
 
     // 메뉴 시스템
@@ -21,12 +33,69 @@ public:
     // 채팅 인터페이스
     void ShowChatScreen(const std::string& characterName);
     void PrintSystem(const std::string& text);
-    void PrintNpc(const std::string& name, const std::string& text);
-    void PrintPlayer(const std::string& text);
+    void PrintNpc(const std::string& name, std::string_view text);
+    void PrintPlayer(std::string_view text);
     void PrintNpcTyped(const std::string& name, const std::string& text);
-    void ShowEvent(const std::string& title, const std::vector<std::string>& lines);
+
+    // 채팅 화면 맨 위 상태 표시줄의 내용입니다. 모르는 수치는 음수이며 "-"로 표시합니다.
+    struct ChatStatus {
+        std::string provider;
+        std::string model;
+        double timeToFirstToken = -1.0;  // 초
+        double tokensPerSecond = -1.0;
+        int promptTokens = -1;
+        int completionTokens = -1;
+        int cachedTokens = -1;  // 제공자의 프롬프트 캐시에서 재사용한 프롬프트 토큰
+        int affection = 0;
+        std::string stage;
+    };
+
+    // 상태 표시줄을 갱신합니다. 타자 효과를 기다리지 않고 바뀐 칸만 제자리에 다시 그립니다.
+    // (설정에서 끈 경우나 채팅 화면이 아닐 때는 내용만 기억해 둡니다)
+    void UpdateStatus(const ChatStatus& status);
+
+    // 조각으로 도착하는 NPC 대사를 타자 효과로 출력합니다. (Begin → Append... → End)
+    // 뒤에 올 조각에 따라 줄바꿈이 바뀔 수 있으므로 완성된 줄만 먼저 내보냅니다.
+    void BeginNpcStream(const std::string& name);
+    void AppendNpcStream(std::string_view text);
+    void EndNpcStream();
+
+    // 키 입력과 다른 스레드의 알림을 처리하는 게임 스레드의 이벤트 루프입니다.
+    EventLoop& Events() { return loop_; }
+
+    // 응답을 기다리며 `done`이 true가 될 때까지 이벤트 루프를 돌립니다. Esc(또는 Ctrl+C)를 누르면
+    // 기다리기를 그만두고 false를 반환합니다. 그 밖의 키는 다음 입력에 쓰이도록 남겨 둡니다.
+    bool WaitForReply(const std::function<bool()>& done);
+
+    // 대화 기록 한 턴 (기록 화면용)
+    struct HistoryEntry {
+        enum class Kind { Player, Npc, System } kind = Kind::System;
+        std::string speaker;
+        std::string text;
+    };
+
+    // 턴 [begin, end)를 순서대로 `out`에 채우는 함수. 기록 화면은 보여줄 만큼만 나눠서 요청합니다.
+    using HistorySource = std::function<void(std::size_t begin, std::size_t end, std::vector<HistoryEntry>& out)>;
+
+    // 최근 대화를 화면 한 장 분량만 다시 출력합니다. (기록 길이와 관계없이 일정한 비용)
+    void ShowRecentHistory(std::size_t turnCount, const HistorySource& source);
+
+    // 대화 기록 화면. PgUp/PgDn, ↑/↓로 넘기고 Esc/q/Enter로 닫습니다. 오래된 턴은 넘길 때 불러옵니다.
+    void BrowseHistory(std::size_t turnCount, const HistorySource& source);
+
+    // 이벤트 연출 화면 (BeginEvent → 대사/선택지 → EndEvent)
+    void BeginEvent(const std::string& title);
+    void ShowEventLine(const std::string& speaker, const std::string& text);
+    std::size_t ShowEventChoices(const std::vector<std::string>& options);
+    void EndEvent();
+
+    // 줄을 입력받습니다. Ctrl+C를 누르면 종료를 요청하고 빈 문자열을 반환합니다.
     std::string ReadInput(const std::string& prompt);
     std::string ReadPassword(const std::string& prompt);
+
+    // 줄 입력 중에 Ctrl+C를 눌렀으면 true. 이후의 입력 함수는 키를 기다리지 않고 바로 반환하므로,
+    // 호출자는 이 값을 보고 Game::Run까지 빠져나가 소멸자가 저장과 정리를 마치게 합니다.
+    bool QuitRequested() const { return quitRequested_; }
     
     // API 키 입력 화면
     std::string ShowApiKeyPrompt();
@@ -41,15 +110,77 @@ public:
     // 메인 게임 루프에서 플레이어 입력 받기
     std::string GetPlayerInput(const std::string& playerName);
     
-    // 텍스트 출력 (타이핑 효과)
+    // 텍스트 출력 (타이핑 효과). 렌더 스레드가 출력하므로 기다리지 않고 바로 반환합니다.
     void PrintChunk(const std::string& chunk);
     void NewLine();
 
+    // 타이핑 중인 텍스트가 모두 출력될 때까지 기다립니다. 키를 누르면 남은 텍스트를 한 번에 출력합니다.
+    // 기다리는 동안에도 이벤트 루프가 돌므로 다른 스레드의 알림과 타이머가 처리됩니다.
+    void FinishTyping();
+
     // 헬퍼 함수
     void ClearScreen();
     void WaitForKey();
 
 private:
     void RenderMenu(int selectedIndex);
-    void SetupConsole();
+    void RenderHistory(std::int64_t top, int pageRows, std::size_t turnCount);
+
+    // 턴 [begin, end)를 불러와 스크롤백의 앞이나 뒤에 덧붙입니다.
+    void LoadHistory(const HistorySource& source, std::size_t begin, std::size_t end, bool prepend);
+
+    // 앞선 출력 뒤에 텍스트를 즉시 출력합니다. 줄을 입력받는 중이면 입력 줄 위에 끼워 넣습니다.
+    void Print(std::string_view text);
+
+    // 표준 입력에 도착한 키를 모두 읽어 키 큐에 넣습니다. (이벤트 루프의 입력 핸들러)
+    void OnInput();
+
+    // 키 큐에서 키 하나를 꺼냅니다. 비어 있으면 이벤트를 처리하며 기다립니다.
+    Terminal::Key NextKey();
+
+    // 완성된 스트리밍 대사 줄을 타자 효과 큐에 넘깁니다. `all`이면 마지막 줄까지 넘깁니다.
+    void FlushStream(bool all);
+
+    // 상태 표시줄을 그립니다. 터미널 크기가 바뀌었으면 스크롤 영역부터 다시 잡습니다.
+    void RenderStatus();
+
+    // 상태 표시줄을 감추고 스크롤 영역을 화면 전체로 되돌립니다.
+    void HideStatus();
+
+    // Ctrl+C를 누르면 종료를 요청합니다. 터미널 설정은 소멸자가 되돌립니다.
+    void RequestQuit();
+
+    // 줄 단위 출력용으로 텍스트를 현재 터미널 폭에 맞춰 줄바꿈합니다.
+    std::string Wrapped(std::string_view text);
+
+    Terminal terminal_;
+    ScreenBuffer screen_;     // 전체 화면(메뉴)을 그릴 때 쓰는 오프스크린 버퍼
+    LayoutCache layouts_;     // 턴별 줄바꿈 결과 (턴 번호, 폭)
+    Scrollback scrollback_;   // 줄바꿈을 마친 대화 기록 (화면 폭 기준)
+    std::vector<HistoryEntry> historyBatch_;
+    std::vector<std::string> wrapped_;  // 줄 단위 출력의 줄바꿈 결과를 재사용하는 버퍼
+    EventLoop loop_;
+    std::deque<Terminal::Key> keys_;  // 읽었지만 아직 쓰지 않은 키 (미리 입력한 글자 포함)
+
+    bool editing_ = false;    // ReadInput이 줄을 입력받는 중인지
+    std::string editPrompt_;
+    std::string editLine_;
+
+    bool quitRequested_ = false;    // 종료 요청 뒤에는 NextKey가 기다리지 않고 중단 키를 돌려줍니다.
+
+    bool awaitingReply_ = false;    // WaitForReply 중인지
+    bool cancelRequested_ = false;
+
+    std::string streamText_;        // 스트리밍 중인 대사 전체 (화자 포함)
+    std::size_t streamLines_ = 0;   // 그중 끝까지 출력한 줄 수
+    std::size_t streamColumn_ = 0;  // 출력 중인 줄에서 이미 낸 바이트 수 (0이면 아직 줄을 시작하지 않음)
+
+    // 상태 표시줄은 맨 윗줄을 차지하고, 대화는 그 아래 스크롤 영역에서만 흐릅니다.
+    bool statusEnabled_ = true;   // 설정의 statusBar
+    bool statusVisible_ = false;  // 지금 채팅 화면에 보이는지
+    int statusRows_ = 0;          // 스크롤 영역을 잡을 때의 터미널 높이
+    ChatStatus status_;
+    ScreenBuffer statusBuffer_;   // 맨 윗줄 하나만 맡는 버퍼
+
+    Typewriter typewriter_;   // 모든 줄 단위 출력이 거치는 렌더 스레드
 };
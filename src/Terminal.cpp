@@ -0,0 +1,265 @@
+#include "Terminal.h"
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+
+#ifdef _WIN32
+#include <conio.h>
+#include <windows.h>
+#else
+#include <cerrno>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <termios.h>
+#include <unistd.h>
+#endif
+
+namespace {
+constexpr std::string_view kClear = "\x1b[H\x1b[2J";
+constexpr std::string_view kShowCursor = "\x1b[?25h";
+constexpr std::string_view kHideCursor = "\x1b[?25l";
+constexpr std::string_view kEnterAlternate = "\x1b[?1049h";
+constexpr std::string_view kLeaveAlternate = "\x1b[?1049l";
+
+Terminal::Key FromByte(int c) {
+    Terminal::Key key;
+    if (c == '\r' || c == '\n') {
+        key.code = Terminal::KeyCode::Enter;
+    } else if (c == '\b' || c == 127) {
+        key.code = Terminal::KeyCode::Backspace;
+    } else if (c == 3) {
+        key.code = Terminal::KeyCode::Interrupt;
+    } else if (c == 27) {
+        key.code = Terminal::KeyCode::Escape;
+    } else if (c >= 32) {
+        key.code = Terminal::KeyCode::Char;
+        key.ch = static_cast<char>(c);
+    }
+    return key;
+}
+}  // 익명 네임스페이스 종료
+
+Terminal::Terminal() {
+    Setup();
+}
+
+Terminal::~Terminal() {
+    if (rawInput_) SetRawInput(false);
+    if (!cursorVisible_) SetCursorVisible(true);
+}
+
+Terminal::Key Terminal::ReadKey() {
+    Key key;
+    PollKey(key, -1);
+    return key;
+}
+
+void Terminal::Clear() {
+    Write(kClear);
+}
+
+void Terminal::SetCursorVisible(bool visible) {
+    cursorVisible_ = visible;
+    Write(visible ? kShowCursor : kHideCursor);
+}
+
+void Terminal::SetAlternateScreen(bool enabled) {
+    Write(enabled ? kEnterAlternate : kLeaveAlternate);
+}
+
+#ifdef _WIN32
+
+void Terminal::Setup() {
+    SetConsoleOutputCP(CP_UTF8);
+
+    HANDLE hOut = GetStdHandle(STD_OUTPUT_HANDLE);
+    if (hOut == INVALID_HANDLE_VALUE) return;
+
+    // ANSI 이스케이프 시퀀스를 콘솔이 직접 해석하도록 합니다. (Windows 10 이상)
+    DWORD mode = 0;
+    if (GetConsoleMode(hOut, &mode)) {
+        SetConsoleMode(hOut, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+    }
+
+    // 가독성 좋은 모노스페이스 Consolas, 더 큰 글꼴 높이(24px)
+    CONSOLE_FONT_INFOEX cfi;
+    cfi.cbSize = sizeof(cfi);
+    GetCurrentConsoleFontEx(hOut, FALSE, &cfi);
+    cfi.dwFontSize.Y = 24;
+    cfi.FontWeight = FW_NORMAL;
+    wcscpy_s(cfi.FaceName, L"Consolas");
+    SetCurrentConsoleFontEx(hOut, FALSE, &cfi);
+
+    // 폭 120컬럼, 스크롤백 3000줄 버퍼와 120 x 40 표시 영역
+    COORD bufferSize = {120, 3000};
+    SetConsoleScreenBufferSize(hOut, bufferSize);
+    SMALL_RECT windowSize = {0, 0, 119, 39};
+    SetConsoleWindowInfo(hOut, TRUE, &windowSize);
+
+    SetConsoleTitleW(L"AI 연애 시뮬레이터 - 봄날의 추억");
+}
+
+void Terminal::SetRawInput(bool enabled) {
+    // _getch는 원래 에코 없이 한 키씩 읽으므로 바꿀 콘솔 모드가 없습니다.
+    rawInput_ = enabled;
+}
+
+bool Terminal::PollKey(Key& key, int timeoutMs) {
+    if (timeoutMs >= 0) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+        while (!_kbhit()) {
+            if (std::chrono::steady_clock::now() >= deadline) {
+                // 이벤트 루프가 깨운 경우 남은 것은 키가 아닌 입력(키 떼기, 마우스, 포커스)뿐입니다.
+                // 비워 두지 않으면 콘솔 입력 핸들이 계속 신호 상태로 남아 루프가 쉬지 못합니다.
+                if (timeoutMs == 0) FlushConsoleInputBuffer(GetStdHandle(STD_INPUT_HANDLE));
+                return false;
+            }
+            Sleep(1);
+        }
+    }
+    int c = _getch();
+    if (c == 0 || c == 224) {  // 방향키 등 확장 키 프리픽스
+        key = Key{};
+        switch (_getch()) {
+            case 72: key.code = KeyCode::Up; break;
+            case 80: key.code = KeyCode::Down; break;
+            case 75: key.code = KeyCode::Left; break;
+            case 77: key.code = KeyCode::Right; break;
+            case 73: key.code = KeyCode::PageUp; break;
+            case 81: key.code = KeyCode::PageDown; break;
+            default: break;
+        }
+        return true;
+    }
+    key = FromByte(c);
+    return true;
+}
+
+void Terminal::Size(int& columns, int& rows) const {
+    columns = 80;
+    rows = 24;
+    CONSOLE_SCREEN_BUFFER_INFO info;
+    if (GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &info)) {
+        columns = info.srWindow.Right - info.srWindow.Left + 1;
+        rows = info.srWindow.Bottom - info.srWindow.Top + 1;
+    }
+}
+
+void Terminal::Write(std::string_view bytes) {
+    std::cout.flush();
+    std::fwrite(bytes.data(), 1, bytes.size(), stdout);
+    std::fflush(stdout);
+}
+
+#else
+
+namespace {
+// SetRawInput(true) 이전의 터미널 설정. 콘솔은 프로세스에 하나뿐이므로 파일 범위에 둡니다.
+termios savedMode;
+bool savedModeValid = false;
+
+// 비정규 모드: 줄 단위 버퍼링, 에코, 시그널 키(Ctrl+C)를 끄고 한 바이트씩 읽습니다.
+bool EnterRawMode(termios& saved) {
+    if (tcgetattr(STDIN_FILENO, &saved) != 0) return false;
+    termios mode = saved;
+    mode.c_lflag &= ~static_cast<tcflag_t>(ICANON | ECHO | ISIG);
+    mode.c_cc[VMIN] = 1;
+    mode.c_cc[VTIME] = 0;
+    tcsetattr(STDIN_FILENO, TCSANOW, &mode);
+    return true;
+}
+}  // 익명 네임스페이스 종료
+
+void Terminal::Setup() {
+    // POSIX 터미널은 UTF-8과 ANSI 시퀀스를 기본으로 지원하므로 따로 설정할 것이 없습니다.
+}
+
+void Terminal::SetRawInput(bool enabled) {
+    if (enabled == rawInput_) return;
+    if (enabled) {
+        // 입력이 터미널이 아니면(파이프 등) 바꿀 설정이 없지만, 키 단위로 읽는 것은 똑같습니다.
+        savedModeValid = EnterRawMode(savedMode);
+        rawInput_ = true;
+    } else {
+        if (savedModeValid) tcsetattr(STDIN_FILENO, TCSANOW, &savedMode);
+        rawInput_ = false;
+    }
+}
+
+bool Terminal::PollKey(Key& key, int timeoutMs) {
+    std::cout.flush();
+    std::fflush(stdout);
+
+    // 비정규 모드를 유지하고 있지 않으면 이 키를 읽는 동안만 바꿉니다.
+    termios saved;
+    bool raw = !rawInput_ && EnterRawMode(saved);
+
+    // 바이트 값, 시간 초과면 -1, 입력이 닫혔으면(EOF) -2를 반환합니다.
+    auto readByte = [](int timeoutMs) -> int {
+        if (timeoutMs >= 0) {
+            pollfd pfd{STDIN_FILENO, POLLIN, 0};
+            if (poll(&pfd, 1, timeoutMs) <= 0) return -1;
+        }
+        unsigned char c;
+        ssize_t n;
+        do {
+            n = read(STDIN_FILENO, &c, 1);
+        } while (n < 0 && errno == EINTR);
+        return n == 1 ? c : -2;
+    };
+
+    key = Key{};
+    int c = readByte(timeoutMs);
+    bool pressed = c != -1;
+    if (c == 0x1b) {
+        // ESC [ A 형태의 방향키, ESC [ 5 ~ 형태의 페이지 키. 뒤따르는 바이트가 없으면 ESC 단독 입력입니다.
+        int next = readByte(30);
+        if (next == '[' || next == 'O') {
+            switch (readByte(30)) {
+                case 'A': key.code = KeyCode::Up; break;
+                case 'B': key.code = KeyCode::Down; break;
+                case 'C': key.code = KeyCode::Right; break;
+                case 'D': key.code = KeyCode::Left; break;
+                case '5': key.code = readByte(30) == '~' ? KeyCode::PageUp : KeyCode::Other; break;
+                case '6': key.code = readByte(30) == '~' ? KeyCode::PageDown : KeyCode::Other; break;
+                default: break;
+            }
+        } else if (next < 0) {
+            key.code = KeyCode::Escape;
+        }
+    } else if (c == -2) {
+        key.code = KeyCode::Interrupt;  // 입력이 닫혔으면 중단으로 처리합니다.
+    } else {
+        key = FromByte(c);
+    }
+
+    if (raw) tcsetattr(STDIN_FILENO, TCSANOW, &saved);
+    return pressed;
+}
+
+void Terminal::Size(int& columns, int& rows) const {
+    columns = 80;
+    rows = 24;
+    winsize ws{};
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &ws) == 0 && ws.ws_col > 0 && ws.ws_row > 0) {
+        columns = ws.ws_col;
+        rows = ws.ws_row;
+    }
+}
+
+void Terminal::Write(std::string_view bytes) {
+    std::cout.flush();
+    std::fflush(stdout);
+    // 한 프레임을 write() 한 번으로 내보내 중간 상태가 보이지 않게 합니다. (부분 쓰기만 이어서 씁니다)
+    while (!bytes.empty()) {
+        ssize_t n = write(STDOUT_FILENO, bytes.data(), bytes.size());
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        bytes.remove_prefix(static_cast<std::size_t>(n));
+    }
+}
+
+#endif
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <string_view>
+
+/**
+ * 콘솔 입출력의 플랫폼 차이를 감춥니다.
+ *
+ * 출력은 ANSI 이스케이프 시퀀스로 통일하고(Windows에서는 VT 처리를 켭니다), 키 입력은
+ * POSIX에서는 termios 비정규 모드, Windows에서는 _getch로 한 키씩 읽습니다.
+ * SetRawInput(true)로 비정규 모드를 유지하지 않으면 키를 읽는 동안에만 바꿨다가 되돌립니다.
+ */
+class Terminal {
+public:
+    enum class KeyCode {
+        Char,       // 일반 문자 (Key::ch)
+        Up,
+        Down,
+        Left,
+        Right,
+        PageUp,
+        PageDown,
+        Escape,
+        Enter,
+        Backspace,
+        Interrupt,  // Ctrl+C
+        Other
+    };
+
+    struct Key {
+        KeyCode code = KeyCode::Other;
+        char ch = 0;
+    };
+
+    Terminal();
+    ~Terminal();
+
+    Terminal(const Terminal&) = delete;
+    Terminal& operator=(const Terminal&) = delete;
+
+    // 키 하나를 기다려 읽습니다. 방향키처럼 여러 바이트로 오는 키도 하나로 돌려줍니다.
+    Key ReadKey();
+
+    // 최대 timeoutMs 동안 키를 기다립니다. 눌린 키가 있으면 `key`에 담고 true를 반환합니다.
+    bool PollKey(Key& key, int timeoutMs);
+
+    // 비정규 모드(에코 없음, 한 바이트씩, Ctrl+C도 키로 전달)를 계속 유지할지 정합니다.
+    // 켜 두면 입력이 도착하는 즉시 이벤트 루프가 깨어날 수 있습니다.
+    void SetRawInput(bool enabled);
+
+    // 화면 크기(열, 행)를 반환합니다. 알 수 없으면 80x24로 봅니다.
+    void Size(int& columns, int& rows) const;
+
+    // 표준 출력에 남은 내용을 먼저 내보낸 뒤 `bytes`를 한 번에 씁니다.
+    void Write(std::string_view bytes);
+
+    // 화면을 지우고 커서를 왼쪽 위로 옮깁니다. (셸을 띄우지 않습니다)
+    void Clear();
+
+    void SetCursorVisible(bool visible);
+
+    // 대체 화면으로 전환합니다. 돌아오면 전환 전의 화면과 스크롤이 그대로 복원됩니다.
+    void SetAlternateScreen(bool enabled);
+
+private:
+    // 플랫폼별 콘솔 초기 설정 (UTF-8, 창 크기 등)
+    void Setup();
+
+    bool cursorVisible_ = true;
+    bool rawInput_ = false;
+};
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * 터미널에 표시할 텍스트의 폭 계산과 줄바꿈을 담당합니다.
+ *
+ * 글자 폭은 미리 생성한 유니코드 폭 표(East Asian Width, 결합 문자)로 구하므로 한글·한자는 두 칸,
+ * 결합 부호는 0칸으로 계산합니다. 줄은 공백(어절)에서 먼저 나누고, 한 어절이 한 줄보다 길 때만
+ * 글자(음절) 사이에서 나눕니다. 닫는 문장 부호는 줄 머리에, 여는 문장 부호는 줄 끝에 오지 않습니다.
+ */
+class TextLayout {
+public:
+    // UTF-8 한 글자를 읽고 `i`를 다음 글자로 옮깁니다. 잘못된 바이트는 U+FFFD로 바꿉니다.
+    static char32_t Decode(std::string_view text, std::size_t& i);
+
+    // UTF-8 선행 바이트로 한 글자의 바이트 수를 구합니다.
+    static std::size_t GlyphLength(unsigned char lead);
+
+    // 글자 하나가 차지하는 칸 수(0, 1, 2)를 반환합니다.
+    static int Width(char32_t codepoint);
+
+    // UTF-8 텍스트가 차지하는 칸 수를 반환합니다.
+    static int Width(std::string_view text);
+
+    // 텍스트를 폭 `width`에 맞춰 줄 단위로 나눕니다. 줄바꿈 문자는 문단 경계로 봅니다.
+    static void Wrap(std::string_view text, int width, std::vector<std::string>& out);
+};
+
+/**
+ * 턴별 줄바꿈 결과를 (턴 번호, 폭)으로 보관하는 캐시입니다.
+ *
+ * 본문 해시를 함께 저장해 같은 번호의 다른 턴(불러오기 이후 등)은 다시 계산합니다. 폭마다 따로
+ * 보관하므로 창 크기를 바꿨다 되돌려도 다시 계산하지 않으며, 가장 오래 쓰지 않은 항목부터 버립니다.
+ */
+class LayoutCache {
+public:
+    using Lines = std::shared_ptr<const std::vector<std::string>>;
+
+    explicit LayoutCache(std::size_t capacity = 4096);
+
+    // 캐시된 줄바꿈 결과를 반환하고, 없으면 계산해 넣습니다.
+    Lines Get(std::size_t turn, int width, std::string_view text);
+
+    void Clear();
+
+    std::size_t Size() const { return entries_.size(); }
+
+private:
+    struct Key {
+        std::size_t turn;
+        int width;
+
+        bool operator==(const Key& other) const { return turn == other.turn && width == other.width; }
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const {
+            return std::hash<std::size_t>()(key.turn) * 31 + std::hash<int>()(key.width);
+        }
+    };
+
+    struct Entry {
+        std::size_t textHash = 0;
+        Lines lines;
+        std::list<Key>::iterator recency;
+    };
+
+    std::size_t capacity_;
+    std::unordered_map<Key, Entry, KeyHash> entries_;
+    std::list<Key> recency_;  // 앞쪽이 최근에 쓴 항목
+};
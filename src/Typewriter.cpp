@@ -0,0 +1,144 @@
+#include "Typewriter.h"
+
+#include <algorithm>
+
+#include "Terminal.h"
+#include "TextLayout.h"
+
+Typewriter::Typewriter(Terminal& terminal, int charsPerSecond, int frameRate)
+    : terminal_(terminal),
+      charsPerSecond_(std::max(charsPerSecond, 0)),
+      frameInterval_(std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          std::chrono::duration<double>(1.0 / std::clamp(frameRate, 1, 240)))),
+      thread_(&Typewriter::Run, this) {}
+
+Typewriter::~Typewriter() {
+    Stop();
+}
+
+void Typewriter::Type(std::string_view text) {
+    Enqueue(text, charsPerSecond_ > 0);
+}
+
+void Typewriter::Print(std::string_view text) {
+    Enqueue(text, false);
+}
+
+void Typewriter::Enqueue(std::string_view text, bool typed) {
+    if (text.empty()) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // 같은 종류의 조각이 이어지면 하나로 합쳐 큐 길이를 줄입니다.
+        if (!queue_.empty() && queue_.back().typed == typed) {
+            queue_.back().text.append(text);
+        } else {
+            queue_.push_back(Segment{std::string(text), typed, 0});
+        }
+    }
+    wake_.notify_one();
+}
+
+void Typewriter::Overlay(std::string_view bytes) {
+    if (bytes.empty()) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        overlay_.append(bytes);
+    }
+    wake_.notify_one();
+}
+
+void Typewriter::Skip() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (queue_.empty()) return;
+        skip_ = true;
+    }
+    wake_.notify_one();
+}
+
+bool Typewriter::Idle() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.empty() && overlay_.empty() && !writing_;
+}
+
+void Typewriter::SetOnIdle(std::function<void()> onIdle) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    onIdle_ = std::move(onIdle);
+}
+
+void Typewriter::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stop_) return;
+        stop_ = true;
+    }
+    wake_.notify_one();
+    if (thread_.joinable()) thread_.join();
+}
+
+std::string Typewriter::TakeFrame(double& credit) {
+    std::string frame;
+    while (!queue_.empty()) {
+        Segment& segment = queue_.front();
+        if (!segment.typed || skip_ || stop_) {
+            frame.append(segment.text, segment.offset, std::string::npos);
+            queue_.pop_front();
+            continue;
+        }
+        // 프레임 동안 쌓인 만큼만 글자를 꺼냅니다. 공백은 시간을 쓰지 않습니다.
+        while (segment.offset < segment.text.size()) {
+            auto lead = static_cast<unsigned char>(segment.text[segment.offset]);
+            bool blank = lead == ' ' || lead == '\n';
+            if (!blank && credit < 1.0) break;
+            std::size_t length = std::min(TextLayout::GlyphLength(lead), segment.text.size() - segment.offset);
+            frame.append(segment.text, segment.offset, length);
+            segment.offset += length;
+            if (!blank) credit -= 1.0;
+        }
+        if (segment.offset < segment.text.size()) break;
+        queue_.pop_front();
+    }
+    if (queue_.empty()) skip_ = false;
+    return frame;
+}
+
+void Typewriter::Run() {
+    const double perFrame = charsPerSecond_ * std::chrono::duration<double>(frameInterval_).count();
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        wake_.wait(lock, [this] { return stop_ || !queue_.empty() || !overlay_.empty(); });
+        if (queue_.empty() && overlay_.empty()) break;  // 멈추라는 요청이고 남은 출력도 없음
+
+        // 큐가 비어 있다가 새로 시작하면 첫 프레임에 바로 한 글자를 내보냅니다.
+        double credit = 1.0;
+        auto next = std::chrono::steady_clock::now();
+        while (true) {
+            // 프레임은 글자와 시퀀스 경계에서 끝나므로 그 뒤에 오버레이를 붙여도 본문이 깨지지 않습니다.
+            std::string frame = TakeFrame(credit);
+            frame += overlay_;
+            overlay_.clear();
+            if (!frame.empty()) {
+                writing_ = true;
+                lock.unlock();
+                terminal_.Write(frame);
+                lock.lock();
+                writing_ = false;
+            }
+            if (queue_.empty()) break;
+
+            next += frameInterval_;
+            wake_.wait_until(lock, next, [this] { return stop_ || skip_; });
+            // 밀린 프레임 수만큼 글자를 더 내보내되, 한 번에 몰아서 쏟아내지는 않습니다.
+            auto now = std::chrono::steady_clock::now();
+            if (now > next + frameInterval_) next = now;
+            credit = std::min(credit + perFrame, perFrame + 1.0);
+        }
+
+        // 출력을 기다리는 쪽이 주기적으로 확인하지 않아도 되도록 다 썼다고 알립니다.
+        if (auto onIdle = onIdle_) {
+            lock.unlock();
+            onIdle();
+            lock.lock();
+        }
+    }
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+class Terminal;
+
+/**
+ * 타자 효과 출력을 전담하는 렌더 스레드입니다.
+ *
+ * 게임 스레드는 글자를 큐에 넣고 바로 돌아가며, 렌더 스레드가 프레임마다(기본 60Hz) 초당 글자 수만큼
+ * 꺼내 한 번의 쓰기로 내보냅니다. 즉시 출력(Print)도 같은 큐를 거치므로 출력 순서는 항상 유지됩니다.
+ */
+class Typewriter {
+public:
+    // charsPerSecond가 0 이하이면 타자 효과 없이 즉시 출력합니다.
+    Typewriter(Terminal& terminal, int charsPerSecond, int frameRate);
+    ~Typewriter();
+
+    Typewriter(const Typewriter&) = delete;
+    Typewriter& operator=(const Typewriter&) = delete;
+
+    // 타자 효과로 출력할 텍스트를 큐에 넣습니다.
+    void Type(std::string_view text);
+
+    // 앞선 텍스트가 모두 출력된 뒤 한 번에 출력할 텍스트를 큐에 넣습니다. (스트리밍 조각, 시스템 메시지 등)
+    void Print(std::string_view text);
+
+    // 큐 순서와 상관없이 다음 프레임에 덧붙여 쓸 바이트를 넣습니다. 타이핑 중에도 밀리지 않습니다.
+    // 커서 위치를 저장/복원하는 시퀀스로 감싼 상태 표시줄처럼 본문 흐름을 건드리지 않는 출력에만 씁니다.
+    void Overlay(std::string_view bytes);
+
+    // 지금 큐에 있는 텍스트를 다음 프레임에 모두 출력합니다. (건너뛰기)
+    void Skip();
+
+    // 큐와 오버레이가 비었고 쓰는 중인 프레임도 없으면 true를 반환합니다.
+    bool Idle() const;
+
+    // 큐를 모두 출력해 Idle()이 될 때마다 렌더 스레드에서 호출할 알림 함수를 설정합니다.
+    void SetOnIdle(std::function<void()> onIdle);
+
+    // 남은 텍스트를 모두 즉시 출력하고 렌더 스레드를 멈춥니다. 여러 번 호출해도 안전합니다.
+    void Stop();
+
+    std::chrono::milliseconds FrameInterval() const {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(frameInterval_);
+    }
+
+private:
+    struct Segment {
+        std::string text;
+        bool typed = false;
+        std::size_t offset = 0;  // 이미 출력한 바이트 수
+    };
+
+    void Enqueue(std::string_view text, bool typed);
+    void Run();
+
+    // 이번 프레임에 출력할 바이트를 큐에서 꺼냅니다. (mutex_를 잡은 상태에서 호출)
+    std::string TakeFrame(double& credit);
+
+    Terminal& terminal_;
+    const double charsPerSecond_;
+    const std::chrono::steady_clock::duration frameInterval_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::deque<Segment> queue_;
+    std::string overlay_;
+    bool skip_ = false;
+    bool writing_ = false;
+    bool stop_ = false;
+    std::function<void()> onIdle_;
+    std::thread thread_;
+};
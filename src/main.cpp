@@ -5,6 +5,7 @@
 #include <windows.h>
 #endif
 
+#include "AssetBundle.h"
 #include "Config.h"
 #include "DialogueManager.h"
 #include "Game.h"
@@ -21,17 +22,20 @@ int main(int argc, char** argv) {
     (void)argc;
     (void)argv;
 
+    // 빌드 시 만든 에셋 번들이 있으면 한 번 매핑해 두고, 없으면 data/의 개별 파일을 읽습니다.
+    Assets::Mount("data.pak");
+
     Config config;
     if (!config.Load("data/system/config.json")) {
         std::cerr << "설정 파일을 불러오지 못했습니다. data/system/config.json을 확인하세요.\n";
         return 1;
     }
 
-    TUI ui;
+    TUI ui(config);
 
     DialogueManager dialogueManager(config);
     LLMClient llmClient(config);
-    SaveSystem saveSystem(config.GetSavesDir());
+    SaveSystem saveSystem(config);
 
     Game game(config, ui, dialogueManager, llmClient, saveSystem);
     game.Run();
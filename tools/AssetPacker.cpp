@@ -0,0 +1,17 @@
+#include <iostream>
+
+#include "AssetBundle.h"
+
+// data/ 디렉토리를 실행 시 한 번에 매핑할 수 있는 번들 파일로 묶습니다.
+// 사용법: AssetPacker <data 디렉토리> <출력 번들 경로>
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        std::cerr << "사용법: AssetPacker <data 디렉토리> <출력 번들 경로>\n";
+        return 1;
+    }
+    if (!AssetBundle::Build(argv[1], "data", argv[2])) {
+        std::cerr << "에셋 번들을 만들지 못했습니다: " << argv[2] << '\n';
+        return 1;
+    }
+    return 0;
+}
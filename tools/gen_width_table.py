@@ -0,0 +1,53 @@
+#!/usr/bin/env python3
+"""Generate the display-width range table used by src/TextLayout.cpp.
+
+Width 2: East Asian Width W/F (unassigned code points in planes 2-3 count as wide).
+Width 0: combining marks (Mn/Me), format characters (Cf, except soft hyphen) and
+         Hangul medial vowels / final consonants that join the previous jamo.
+Everything else (>= U+0300) is width 1 and is not listed. Unassigned code points
+are merged into the surrounding range to keep the table short.
+
+Usage: python3 tools/gen_width_table.py > table.inc
+"""
+import unicodedata
+
+
+def width(cp):
+    ch = chr(cp)
+    category = unicodedata.category(ch)
+    if category == "Cn":
+        return 2 if 0x20000 <= cp <= 0x3FFFD else None
+    if category in ("Mn", "Me") or (category == "Cf" and cp != 0xAD):
+        return 0
+    if 0x1160 <= cp <= 0x11FF or 0xD7B0 <= cp <= 0xD7FF:
+        return 0
+    if unicodedata.east_asian_width(ch) in ("W", "F"):
+        return 2
+    return 1
+
+
+def main():
+    ranges = []
+    open_range = False
+    for cp in range(0x300, 0x110000):
+        if 0xD800 <= cp <= 0xDFFF:
+            continue
+        w = width(cp)
+        if w is None:
+            continue
+        if w == 1:
+            open_range = False
+            continue
+        if open_range and ranges[-1][2] == w:
+            ranges[-1][1] = cp
+        else:
+            ranges.append([cp, cp, w])
+        open_range = True
+
+    print(f"// Unicode {unicodedata.unidata_version}, generated by tools/gen_width_table.py ({len(ranges)} ranges)")
+    for i in range(0, len(ranges), 4):
+        print("    " + " ".join(f"{{0x{a:05X}, 0x{b:05X}, {w}}}," for a, b, w in ranges[i:i + 4]))
+
+
+if __name__ == "__main__":
+    main()